@@ -0,0 +1,115 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "bench.h"
+
+#include "catch23/generators.h"
+#include "catch23/test_result_handler.h"
+#include "catchkit/matchers.h"
+
+#include <string>
+
+using namespace CatchKit::Bench;
+
+namespace {
+    // Read through a volatile, so the compiler can't work out the results of the assertions
+    volatile int zero_source = 0;
+}
+
+BENCHMARK("raw if (for comparison)", iterations) {
+    int failures = 0;
+    for( int i = 0; i < iterations; ++i ) {
+        if( i < zero_source )
+            ++failures;
+    }
+    zero_source = failures;
+}
+
+BENCHMARK("passing CHECK", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i >= zero );
+}
+
+BENCHMARK("failing CHECK", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i < zero );
+}
+
+BENCHMARK("passing REQUIRE", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        REQUIRE( i >= zero );
+}
+
+BENCHMARK("failing REQUIRE", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i ) {
+        try {
+            REQUIRE( i < zero );
+        }
+        catch( CatchKit::Detail::TestCancelled ) { // NOSONAR NOLINT (misc-typo)
+            // carry on, so we measure many failures in one run
+        }
+    }
+}
+
+BENCHMARK("passing CHECK_THAT (composite matcher)", iterations) {
+    using namespace CatchKit::Matchers;
+    for( int i = 0; i < iterations; ++i )
+        CHECK_THAT( i * 0.5, is_close_to( i * 0.5 ) && !is_close_to( -1.0 ) );
+}
+
+BENCHMARK("failing CHECK_THAT (composite matcher)", iterations) {
+    using namespace CatchKit::Matchers;
+    std::string const text = "the quick brown fox";
+    for( int i = 0; i < iterations; ++i )
+        CHECK_THAT( text, starts_with( "the" ) && contains( "slow" ) );
+}
+
+BENCHMARK("CAPTURE, then passing CHECK", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i ) {
+        CAPTURE( i );
+        CHECK( i >= zero );
+    }
+}
+
+BENCHMARK("CAPTURE, then failing CHECK", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i ) {
+        CAPTURE( i );
+        CHECK( i < zero );
+    }
+}
+
+BENCHMARK("passing CHECK with << message", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i >= zero ) << "value was " << i;
+}
+
+BENCHMARK("failing CHECK with << message", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i < zero ) << "value was " << i;
+}
+
+// Every SECTION after the first is skipped on this path, so this is the cost of finding the section and deciding not to enter it
+BENCHMARK("SECTION encountered", iterations) {
+    for( int i = 0; i < iterations; ++i ) {
+        SECTION( "section" ) {
+            zero_source = 0;
+        }
+    }
+}
+
+// Each generated value is a new path through the test, so this includes re-running the test itself
+BENCHMARK("GENERATE path", 1'000) {
+    auto i = GENERATE( 1'000, values_of<int>{} );
+    zero_source = i;
+    int const value = zero_source;
+    CHECK( value == i );
+}
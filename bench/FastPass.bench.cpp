@@ -0,0 +1,26 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+// The same assertions as in Assertions.bench.cpp, but able to take the fast path
+#define CATCHKIT_CONFIG_FAST_PASS
+
+#include "bench.h"
+
+using namespace CatchKit::Bench;
+
+namespace {
+    volatile int zero_source = 0;
+}
+
+BENCHMARK("passing CHECK (fast pass)", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i >= zero );
+}
+
+BENCHMARK("failing CHECK (fast pass)", iterations) {
+    int const zero = zero_source;
+    for( int i = 0; i < iterations; ++i )
+        CHECK( i < zero );
+}
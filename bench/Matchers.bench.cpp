@@ -0,0 +1,209 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "bench.h"
+
+#include "catchkit/matchers.h"
+#include "catchkit/string_search.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace CatchKit::Bench;
+
+namespace {
+    // Large enough that comparing them is dominated by memory bandwidth
+    constexpr std::size_t buffer_size = 16 * 1024 * 1024;
+
+    template<typename Container>
+    auto get_buffer() -> Container const& {
+        static Container const buffer( buffer_size, 0x5a ); // NOSONAR NOLINT (misc-typo)
+        return buffer;
+    }
+    template<typename Container>
+    auto get_buffer_copy() -> Container const& {
+        static Container const buffer = get_buffer<Container>(); // NOSONAR NOLINT (misc-typo)
+        return buffer;
+    }
+
+    // A range, with each element repeated about four times, and a shuffled copy of it
+    template<typename T, std::size_t size>
+    auto get_shuffled_ranges() -> std::pair<std::vector<T>, std::vector<T>> const& {
+        static auto const ranges = [] { // NOSONAR NOLINT (misc-typo)
+            std::mt19937 rng( 42 );
+            std::pair<std::vector<T>, std::vector<T>> ranges;
+            ranges.first.reserve( size );
+            for( std::size_t i = 0; i < size; ++i ) {
+                auto value = static_cast<int>( rng() % ( size / 4 + 1 ) );
+                if constexpr( std::is_same_v<T, std::string> )
+                    ranges.first.push_back( "element " + std::to_string( value ) );
+                else
+                    ranges.first.push_back( value );
+            }
+            ranges.second = ranges.first;
+            std::ranges::shuffle( ranges.second, rng );
+            return ranges;
+        }();
+        return ranges;
+    }
+
+    template<typename T, std::size_t size>
+    void check_equals_in_any_order( CatchKit::Checker& checker, std::size_t operations ) {
+        using namespace CatchKit::Matchers;
+        auto const& [expected, actual] = get_shuffled_ranges<T, size>();
+        for( std::size_t i = 0; i < operations; ++i )
+            CHECK_THAT( actual, equals<InAnyOrder>( expected ) );
+    }
+    template<typename T, std::size_t size>
+    void check_contains( CatchKit::Checker& checker, std::size_t operations ) {
+        using namespace CatchKit::Matchers;
+        auto const& [needles, haystack] = get_shuffled_ranges<T, size>();
+        for( std::size_t i = 0; i < operations; ++i )
+            CHECK_THAT( haystack, contains( needles ) );
+    }
+}
+
+// A deque isn't contiguous, so this is the element by element comparison, for comparison
+BENCHMARK("equals on 16MB of bytes, in a deque", 10) {
+    using namespace CatchKit::Matchers;
+    for( int i = 0; i < 10; ++i )
+        CHECK_THAT( (get_buffer_copy<std::deque<std::uint8_t>>()), equals( get_buffer<std::deque<std::uint8_t>>() ) );
+}
+
+BENCHMARK("equals on 16MB of bytes, in a vector", 10) {
+    using namespace CatchKit::Matchers;
+    for( int i = 0; i < 10; ++i )
+        CHECK_THAT( (get_buffer_copy<std::vector<std::uint8_t>>()), equals( get_buffer<std::vector<std::uint8_t>>() ) );
+}
+
+// Small ranges are compared pair by pair, then larger ones sorted (integers) or hashed (strings).
+// Strings stop at 10^6, as two copies of 10^7 would take most of a gigabyte
+
+BENCHMARK("equals<InAnyOrder> on 10 ints", 10'000) { check_equals_in_any_order<int, 10>( checker, 10'000 ); }
+BENCHMARK("equals<InAnyOrder> on 1000 ints", 100) { check_equals_in_any_order<int, 1'000>( checker, 100 ); }
+BENCHMARK("equals<InAnyOrder> on 10^5 ints", 10) { check_equals_in_any_order<int, 100'000>( checker, 10 ); }
+BENCHMARK("equals<InAnyOrder> on 10^7 ints", 1) { check_equals_in_any_order<int, 10'000'000>( checker, 1 ); }
+
+BENCHMARK("contains(range) on 10 ints", 10'000) { check_contains<int, 10>( checker, 10'000 ); }
+BENCHMARK("contains(range) on 1000 ints", 100) { check_contains<int, 1'000>( checker, 100 ); }
+BENCHMARK("contains(range) on 10^5 ints", 10) { check_contains<int, 100'000>( checker, 10 ); }
+BENCHMARK("contains(range) on 10^7 ints", 1) { check_contains<int, 10'000'000>( checker, 1 ); }
+
+BENCHMARK("equals<InAnyOrder> on 10 strings", 10'000) { check_equals_in_any_order<std::string, 10>( checker, 10'000 ); }
+BENCHMARK("equals<InAnyOrder> on 1000 strings", 100) { check_equals_in_any_order<std::string, 1'000>( checker, 100 ); }
+BENCHMARK("equals<InAnyOrder> on 10^5 strings", 10) { check_equals_in_any_order<std::string, 100'000>( checker, 10 ); }
+BENCHMARK("equals<InAnyOrder> on 10^6 strings", 1) { check_equals_in_any_order<std::string, 1'000'000>( checker, 1 ); }
+
+BENCHMARK("contains(range) on 10 strings", 10'000) { check_contains<std::string, 10>( checker, 10'000 ); }
+BENCHMARK("contains(range) on 1000 strings", 100) { check_contains<std::string, 1'000>( checker, 100 ); }
+BENCHMARK("contains(range) on 10^5 strings", 10) { check_contains<std::string, 100'000>( checker, 10 ); }
+BENCHMARK("contains(range) on 10^6 strings", 1) { check_contains<std::string, 1'000'000>( checker, 1 ); }
+
+// A new matcher each time, as in a loop or generator - so this is mostly finding the pattern in the cache
+BENCHMARK("matches_regex, made each time (simple pattern)", iterations) {
+    using namespace CatchKit::Matchers;
+    std::string const text = "this string contains 'abc' as a substring";
+    for( int i = 0; i < iterations; ++i )
+        CHECK_THAT( text, matches_regex( "^.* 'abc' .*$" ) );
+}
+
+BENCHMARK("matches_regex, made each time (std::regex)", iterations) {
+    using namespace CatchKit::Matchers;
+    std::string const text = "this string contains 'abc' as a substring";
+    for( int i = 0; i < iterations; ++i )
+        CHECK_THAT( text, matches_regex( "^this (\\w+) contains '[a-c]+' .*$" ) );
+}
+
+namespace {
+    // Several megabytes, with the match right at the end
+    auto get_log_payload() -> std::string const& {
+        static std::string const payload = [] { // NOSONAR NOLINT (misc-typo)
+            std::string payload;
+            while( payload.size() < 8 * 1024 * 1024 )
+                payload += "2026-10-17 12:00:00 INFO request handled in 12ms\n";
+            return payload + "2026-10-17 12:00:01 ERROR Connection Reset\n";
+        }();
+        return payload;
+    }
+}
+
+BENCHMARK("case insensitive search of 8MB (scalar, for comparison)", 10) {
+    auto const& payload = get_log_payload();
+    for( int i = 0; i < 10; ++i )
+        CHECK( CatchKit::Detail::find_ignoring_case_scalar( payload, "error connection reset" ) != std::string_view::npos );
+}
+
+BENCHMARK("contains<CaseInsensitive> on 8MB", 10) {
+    using namespace CatchKit::Matchers;
+    auto const& payload = get_log_payload();
+    for( int i = 0; i < 10; ++i )
+        CHECK_THAT( payload, contains<CaseInsensitive>( "error connection reset" ) );
+}
+
+BENCHMARK("equals<CaseInsensitive> on 8MB", 10) {
+    using namespace CatchKit::Matchers;
+    auto const& payload = get_log_payload();
+    static std::string const upper = [&] { // NOSONAR NOLINT (misc-typo)
+        auto upper = payload;
+        for( auto& c : upper )
+            c = static_cast<char>( std::toupper( static_cast<unsigned char>( c ) ) );
+        return upper;
+    }();
+    for( int i = 0; i < 10; ++i )
+        CHECK_THAT( payload, equals<CaseInsensitive>( upper ) );
+}
+
+namespace {
+    auto get_results() -> std::vector<double> const& {
+        static auto const results = [] { // NOSONAR NOLINT (misc-typo)
+            std::vector<double> results( 1'000'000 );
+            for( std::size_t i = 0; i < results.size(); ++i )
+                results[i] = std::sin( static_cast<double>( i ) );
+            return results;
+        }();
+        return results;
+    }
+    auto get_results_copy() -> std::vector<double> const& {
+        static auto const results = get_results(); // NOSONAR NOLINT (misc-typo)
+        return results;
+    }
+}
+
+// The way to do it without all_close_to, for comparison
+BENCHMARK("is_close_to on each of 1M doubles", 1) {
+    using namespace CatchKit::Matchers;
+    auto const& expected = get_results();
+    auto const& actual = get_results_copy();
+    for( std::size_t i = 0; i < expected.size(); ++i )
+        CHECK_THAT( actual[i], is_close_to( expected[i], 1e-9 ) );
+}
+
+BENCHMARK("all_close_to on 1M doubles", 1) {
+    using namespace CatchKit::Matchers;
+    CHECK_THAT( get_results_copy(), all_close_to( get_results(), 1e-9 ) );
+}
+
+BENCHMARK("all_within_ulp on 1M doubles", 1) {
+    using namespace CatchKit::Matchers;
+    CHECK_THAT( get_results_copy(), all_within_ulp( get_results(), 4 ) );
+}
+
+BENCHMARK("all_match(is_close_to) on 1M doubles", 1) {
+    using namespace CatchKit::Matchers;
+    CHECK_THAT( get_results(), all_match( is_close_to( 0.0, 1.0 ) ) );
+}
+
+BENCHMARK("all_match(is_close_to) on 1M doubles, in parallel", 1) {
+    using namespace CatchKit::Matchers;
+    CHECK_THAT( get_results(), all_match( is_close_to( 0.0, 1.0 ), InParallel::Yes ) );
+}
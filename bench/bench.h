@@ -0,0 +1,44 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_BENCH_H
+#define CATCH23_BENCH_H
+
+#include "catch23/test.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace CatchKit::Bench {
+
+    // How many times most benchmarks repeat the operation they measure, in a single run of their body
+    inline constexpr int iterations = 10'000;
+
+    // A benchmark body is run as a test (through the real runner and handler), then timed against an empty test.
+    // The difference, divided by operations, is the cost of each operation
+    struct Benchmark {
+        std::string_view name;
+        void (*body)( Checker& checker );
+        std::size_t operations;
+    };
+
+    struct BenchmarkRegistrar {
+        explicit BenchmarkRegistrar( Benchmark const& benchmark );
+    };
+
+    auto get_benchmarks() -> std::vector<Benchmark>&;
+
+} // namespace CatchKit::Bench
+
+#define CATCH23_INTERNAL_BENCHMARK(fname, name, operations) \
+    static void fname(CatchKit::Checker&); \
+    namespace{ CatchKit::Bench::BenchmarkRegistrar const CATCHKIT_INTERNAL_UNIQUE_NAME(bench_registrar)( { name, &fname, operations } ); } \
+    CATCHKIT_WARNINGS_UNSCOPED_SUPPRESS_UNUSED_PARAMETER \
+    static void fname(CatchKit::Checker& checker )
+
+// Measures the cost of each of operations, which the body should perform exactly
+#define BENCHMARK(name, operations) CATCH23_INTERNAL_BENCHMARK( CATCHKIT_INTERNAL_UNIQUE_NAME(catch23_bench_), name, operations )
+
+#endif // CATCH23_BENCH_H
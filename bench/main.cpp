@@ -0,0 +1,156 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "bench.h"
+
+#include "catch23/reporter.h"
+#include "catch23/runner.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CatchKit::Bench {
+
+    BenchmarkRegistrar::BenchmarkRegistrar( Benchmark const& benchmark ) {
+        get_benchmarks().push_back( benchmark );
+    }
+
+    auto get_benchmarks() -> std::vector<Benchmark>& {
+        static std::vector<Benchmark> benchmarks; // NOSONAR NOLINT (misc-typo)
+        return benchmarks;
+    }
+
+    namespace {
+        // Failures are reported (so failing assertions are fully decomposed), but go nowhere
+        class NullReporter : public Reporter {
+        public:
+            [[nodiscard]] auto report_on_what() const -> ReportOn override { return ReportOn::FailingTests; }
+            void on_test_run_start() override { /* no impl */ }
+            void on_test_run_end() override { /* no impl */ }
+            void on_test_start( TestInfo const& ) override { /* no impl */ }
+            void on_test_end( TestInfo const&, Counters const& ) override { /* no impl */ }
+            void on_assertion_start( AssertionContext const& ) override { /* no impl */ }
+            void on_assertion_end( AssertionContext const&, AssertionInfo const& ) override { /* no impl */ }
+            void on_shrink_start() override { /* no impl */ }
+            void on_shrink_found( std::vector<std::string> const&, int ) override { /* no impl */ }
+            void on_no_shrink_found( int ) override { /* no impl */ }
+            void on_shrink_result( ResultType, int ) override { /* no impl */ }
+            void on_shrink_end() override { /* no impl */ }
+        };
+
+        struct Result {
+            std::string_view name;
+            std::size_t operations;
+            double median_ns; // per operation
+            double min_ns;
+            int samples;
+        };
+
+        auto time_run( TestRunner& runner, Detail::Test const& test ) -> std::chrono::nanoseconds {
+            auto start = std::chrono::steady_clock::now();
+            runner.run_test( test );
+            return std::chrono::steady_clock::now() - start;
+        }
+
+        // Each sample times an empty test straight before the benchmark, so the cost of running a test is taken out
+        auto measure( TestRunner& runner, Benchmark const& benchmark, Detail::Test const& empty_test, int samples ) -> Result {
+            Detail::Test test( benchmark.body, TestInfo{ std::source_location::current(), benchmark.name } );
+            time_run( runner, test ); // warm up
+
+            std::vector<double> per_operation;
+            for( int i = 0; i < samples; ++i ) {
+                auto overhead = time_run( runner, empty_test );
+                auto total = time_run( runner, test );
+                auto cost = std::max( total - overhead, std::chrono::nanoseconds::zero() );
+                per_operation.push_back( static_cast<double>( cost.count() ) / static_cast<double>( benchmark.operations ) );
+            }
+            std::ranges::sort( per_operation );
+            return { benchmark.name, benchmark.operations, per_operation[per_operation.size() / 2], per_operation.front(), samples };
+        }
+
+        auto escape_json( std::string_view text ) -> std::string {
+            std::string escaped;
+            for( char c : text ) {
+                if( c == '"' || c == '\\' )
+                    escaped += '\\';
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        // One object per benchmark, so runs can be compared (or plotted) over time
+        void write_json( std::ostream& os, std::vector<Result> const& results ) {
+            auto now = std::chrono::floor<std::chrono::seconds>( std::chrono::system_clock::now() );
+            os << std::format( "{{\n  \"timestamp\": \"{:%FT%TZ}\",\n  \"unit\": \"ns\",\n  \"benchmarks\": [", now );
+            for( auto const& [index, result] : std::views::enumerate( results ) ) {
+                os << std::format(
+                    "{}\n    {{ \"name\": \"{}\", \"operations\": {}, \"median\": {:.3f}, \"min\": {:.3f}, \"samples\": {} }}",
+                    index == 0 ? "" : ",",
+                    escape_json( result.name ), result.operations, result.median_ns, result.min_ns, result.samples );
+            }
+            os << "\n  ]\n}\n";
+        }
+
+        auto parse_int( std::string_view text ) -> int {
+            int value = 0;
+            auto [ptr, ec] = std::from_chars( text.data(), text.data() + text.size(), value );
+            return ec == std::errc() && ptr == text.data() + text.size() ? value : 0;
+        }
+    }
+
+} // namespace CatchKit::Bench
+
+// Usage: Catch23Bench [--samples <n>] [--json <file>] [name filter...]
+// Any name filters select benchmarks whose names contain them
+int main( int argc, char** argv ) {
+    using namespace CatchKit;
+    using namespace CatchKit::Bench;
+
+    int samples = 15;
+    std::string json_file;
+    std::vector<std::string_view> filters;
+    for( int i = 1; i < argc; ++i ) {
+        std::string_view arg = argv[i];
+        if( arg == "--samples" && i + 1 < argc )
+            samples = parse_int( argv[++i] );
+        else if( arg == "--json" && i + 1 < argc )
+            json_file = argv[++i];
+        else
+            filters.push_back( arg );
+    }
+    if( samples <= 0 ) {
+        std::println( stderr, "--samples must be a positive number" );
+        return 1;
+    }
+
+    NullReporter reporter;
+    TestRunner runner( reporter, Config{} );
+    Detail::Test empty_test( []( Checker& ) { /* just the overhead of running a test */ },
+        TestInfo{ std::source_location::current(), "empty" } );
+
+    std::vector<Result> results;
+    for( auto const& benchmark : get_benchmarks() ) {
+        if( !filters.empty() && std::ranges::none_of( filters, [&]( auto filter ) { return benchmark.name.contains( filter ); } ) )
+            continue;
+        auto const& result = results.emplace_back( measure( runner, benchmark, empty_test, samples ) );
+        std::println( "{:<48} {:>10.2f} ns/op  (min {:.2f})", result.name, result.median_ns, result.min_ns );
+    }
+
+    if( !json_file.empty() ) {
+        std::ofstream os( json_file );
+        if( !os ) {
+            std::println( stderr, "Could not write to {}", json_file );
+            return 1;
+        }
+        write_json( os, results );
+    }
+}
@@ -14,6 +14,19 @@ namespace CatchKit {
         bool break_into_debugger = false;
         std::string tests_or_tags;
         std::string reporter;
+        int jobs = 1; // number of threads to run tests on
+        int shard_count = 1;
+        int shard_index = 0;
+        int shrink_batch = 1; // how many shrink candidates to try at once, each on its own thread
+        bool split_paths = false; // run the paths through each test across -j threads, instead of whole tests
+        bool fork_workers = false; // run tests in a pool of forked processes (POSIX only)
+        std::string durations_file; // records test durations, and uses them for scheduling
+        std::string shard_durations_file; // balances shards by these durations - only read, so every shard sees the same
+        int timeout = 0; // default time limit for each test, in milliseconds (0 for none)
+        int abort_after = 0; // stop the run once this many tests have failed (0 to run everything)
+        int max_elements = 100; // how many elements of each range to show, when stringified (0 for all)
+        int max_chars = 16'384; // how long any one stringified value can get (0 for no limit)
+        int max_depth = 8; // how deeply nested ranges are shown, when stringified (0 for no limit)
         bool help = false;
     };
 
@@ -0,0 +1,66 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_DURATION_HISTORY_H
+#define CATCH23_DURATION_HISTORY_H
+
+#include "test_info.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // How long tests took in previous runs, keyed by hash_test_identity().
+    // The file is a small header followed by a sorted array of fixed size entries, so it can be
+    // mapped straight into memory and searched in place - even for very large test suites
+    class DurationHistory {
+    public:
+        struct Entry {
+            std::uint64_t key;
+            std::int64_t nanoseconds; // smoothed over recent runs
+            std::uint32_t runs;
+            std::uint32_t reserved = 0;
+        };
+
+    private:
+        std::span<Entry const> entries; // either in mapped_data or owned_entries
+        void* mapped_data = nullptr;
+        std::size_t mapped_size = 0;
+        std::vector<Entry> owned_entries;
+        std::vector<Entry> new_measurements;
+        std::chrono::nanoseconds mean_duration{};
+
+        void unmap();
+
+    public:
+        DurationHistory() = default;
+        ~DurationHistory();
+
+        DurationHistory( DurationHistory const& ) = delete;
+        auto operator=( DurationHistory const& ) -> DurationHistory& = delete;
+
+        // Returns false (and remains empty) if the file does not exist or is not a valid history file
+        auto load( std::string const& path ) -> bool;
+
+        // Merges new measurements with the loaded entries and writes them out
+        auto save( std::string const& path ) const -> bool;
+
+        void record( TestInfo const& test_info, std::chrono::nanoseconds duration );
+
+        [[nodiscard]] auto find( TestInfo const& test_info ) const -> std::optional<std::chrono::nanoseconds>;
+        [[nodiscard]] auto empty() const { return entries.empty(); }
+        [[nodiscard]] auto size() const { return entries.size(); }
+
+        // The recorded duration, or the mean of all recorded durations for tests we have not seen before
+        [[nodiscard]] auto estimate( TestInfo const& test_info ) const -> std::chrono::nanoseconds;
+    };
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_DURATION_HISTORY_H
@@ -0,0 +1,81 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_EVENT_STREAM_H
+#define CATCH23_EVENT_STREAM_H
+
+#include "reporter.h"
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace CatchKit::Detail {
+
+    // Serialises reporter events into length-prefixed binary frames.
+    // This is intended for talking to a process forked from this one, so some values
+    // (e.g. source_locations) are written as raw bytes, which are only meaningful in the same binary
+    class EventEncoder : public Reporter {
+        ReportOn what_to_report_on;
+        std::function<void(std::string_view)> flush_to;
+        std::string buffer;
+        std::size_t frame_start = 0;
+
+        void begin_frame( std::uint8_t event_type );
+        void end_frame( bool flush_now = false );
+
+    public:
+        EventEncoder( ReportOn what_to_report_on, std::function<void(std::string_view)> flush_to );
+
+        // Sent after all paths through a test have been run
+        void on_test_complete();
+        void flush();
+
+        [[nodiscard]] auto report_on_what() const -> ReportOn override {
+            return what_to_report_on;
+        }
+
+        void on_test_run_start() override;
+        void on_test_run_end() override;
+
+        void on_test_start( TestInfo const& test_info ) override;
+        void on_test_end( TestInfo const& test_info, Counters const& assertions ) override;
+
+        void on_assertion_start( AssertionContext const& context ) override;
+        void on_assertion_end( AssertionContext const& context, AssertionInfo const& assertion_info ) override;
+
+        void on_shrink_start() override;
+        void on_shrink_found( std::vector<std::string> const& values, int shrinks ) override;
+        void on_no_shrink_found( int shrinks ) override;
+        void on_shrink_result( ResultType result, int shrinks_so_far ) override;
+        void on_shrink_end() override;
+    };
+
+    // Reads frames written by an EventEncoder and forwards them on to another reporter
+    class EventDecoder {
+        // Backs any string_views handed on to the target reporter, until release_strings() is called
+        std::deque<std::string> strings;
+        std::optional<std::source_location> last_location;
+        bool in_test = false;
+        bool shrinking = false;
+
+        auto store( std::string_view str ) -> std::string_view;
+
+    public:
+        // Decodes all complete frames at the start of inbox (removing them), forwarding them to target.
+        // Returns true if the end of the test was seen
+        auto decode( std::string& inbox, Reporter& target, TestInfo const& test_info ) -> bool;
+
+        void release_strings() { strings.clear(); }
+        void reset();
+
+        [[nodiscard]] auto is_in_test() const { return in_test; }
+        [[nodiscard]] auto is_shrinking() const { return shrinking; }
+        [[nodiscard]] auto get_last_location() const { return last_location; }
+    };
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_EVENT_STREAM_H
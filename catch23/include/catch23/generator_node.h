@@ -124,6 +124,19 @@ namespace CatchKit::Detail {
         std::optional<GeneratedType> pre_shrunk_value;
         std::optional<Shrinker<GeneratorType, GeneratedType>> shrinker;
         std::set<GeneratedType> cache;
+        std::size_t partition_offset = 0;
+        std::size_t partition_stride = 1;
+
+        // Values are still generated for the indices we skip, so random values come out the same
+        // as they would if we visited every index. Returns `true` if we ran out of values
+        auto skip( std::size_t count ) -> bool {
+            for( std::size_t i = 0; i < count; ++i ) {
+                if( increment_current_index() == size )
+                    return true;
+                current_generated_value = generate_value();
+            }
+            return false;
+        }
     public:
         explicit GeneratorNode( NodeId const& id, GeneratorType&& gen )
         :   ExecutionNode(id),
@@ -143,13 +156,52 @@ namespace CatchKit::Detail {
             assert( !shrinker );
             rng.reset();
             current_generated_value = generate_value();
+            skip( partition_offset );
         }
         auto move_next() -> bool override {
             assert( !shrinker );
-            if( increment_current_index() == size )
-                return true;
+            return skip( partition_stride );
+        }
+        auto apply_partition( PathPartition& partition ) -> std::size_t override {
+            assert( get_current_index() == 0 );
+            assert( partition.offset < size );
+            if( partition.seed ) {
+                rng.reseed( *partition.seed );
+                current_generated_value = generate_value();
+            }
+            else
+                partition.seed = rng.get_seed();
+            partition_offset = partition.offset;
+            partition_stride = partition.stride;
+            skip( partition_offset );
+            return size;
+        }
+        void reseed( unsigned int seed ) override {
+            assert( get_current_index() == 0 );
+            rng.reseed( seed );
             current_generated_value = generate_value();
-            return false;
+        }
+
+        // Copies the generator and current value - but nothing to do with shrinking in progress
+        GeneratorNode( GeneratorNode const& other )
+        :   ExecutionNode(other),
+            ShrinkableNode(),
+            generator(other.generator),
+            rng(other.rng),
+            size(other.size),
+            current_generated_value(other.current_generated_value),
+            partition_offset(other.partition_offset),
+            partition_stride(other.partition_stride)
+        {
+            if( IsGeneratorShrinkable<GeneratorType> ) {
+                set_shrinkable(this);
+            }
+        }
+        auto clone_node() const -> std::unique_ptr<ExecutionNode> override {
+            if constexpr( std::copy_constructible<GeneratorType> && std::copy_constructible<GeneratedType> )
+                return std::unique_ptr<ExecutionNode>( new GeneratorNode( *this ) );
+            else
+                return nullptr;
         }
 
         GeneratedType& current_value() {
@@ -184,6 +236,13 @@ namespace CatchKit::Detail {
         auto current_value_as_string() -> std::string override {
             return stringify(current_generated_value);
         }
+        void adopt_shrink_candidate( ShrinkableNode const& candidate ) override {
+            current_generated_value = static_cast<GeneratorNode const&>(candidate).current_generated_value;
+        }
+        void forget_shrink_candidate( ShrinkableNode const& candidate ) override {
+            // Only values we were given by shrink() get here, so if it is in the cache it was put there by that call
+            cache.erase( static_cast<GeneratorNode const&>(candidate).current_generated_value );
+        }
     };
 
 
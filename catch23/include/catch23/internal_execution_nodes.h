@@ -6,6 +6,7 @@
 #define CATCH23_INTERNAL_EXECUTION_NODES_H
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <source_location>
 #include <cassert>
@@ -31,12 +32,26 @@ namespace CatchKit::Detail {
 
     class ExecutionNodes;
 
+    // Selects a subset of the paths through a test: those where the outermost generator is at
+    // offset, offset + stride, offset + 2*stride etc. The seed makes random values match across partitions
+    // (nested generators are seeded from it, too)
+    struct PathPartition {
+        std::size_t offset = 0;
+        std::size_t stride = 1;
+        std::optional<unsigned int> seed = {};
+    };
+
     struct ShrinkableNode {
         virtual void start_shrinking() = 0;
         virtual void rebase_shrink() = 0;
         virtual auto stop_shrinking() -> bool = 0;
         virtual auto shrink() -> bool = 0;
         virtual auto current_value_as_string() -> std::string = 0;
+
+        // For evaluating shrink candidates on copies of the execution nodes.
+        // candidate is the corresponding node in the copy (so is always the same type)
+        virtual void adopt_shrink_candidate( ShrinkableNode const& candidate ) = 0;
+        virtual void forget_shrink_candidate( ShrinkableNode const& candidate ) = 0;
     protected:
         ~ShrinkableNode() = default;
     };
@@ -70,8 +85,23 @@ namespace CatchKit::Detail {
         ShrinkableNode* shrinkable = nullptr; // May be set by derived class
         std::size_t current_index = 0;
     protected:
+        // Copies the state of the node, but not its relationships (parent, children or container)
+        ExecutionNode( ExecutionNode const& other )
+        :   id(other.id),
+            state(other.state),
+            current_index(other.current_index)
+        {}
+        // Returns nullptr if this node can't be copied
+        [[nodiscard]] virtual auto clone_node() const -> std::unique_ptr<ExecutionNode> {
+            return std::unique_ptr<ExecutionNode>( new ExecutionNode( *this ) );
+        }
+
         virtual void move_first() { /* may be implemented in derived class */ }
         virtual auto move_next() -> bool; // `true` means we finished
+        // Returns the number of values this node iterates over, or 0 if it can't be partitioned
+        virtual auto apply_partition( PathPartition& ) -> std::size_t { return 0; }
+        // For nodes nested within a partitioned one, so they generate the same values in every partition
+        virtual void reseed( unsigned int ) { /* only nodes that generate random values need this */ }
         void set_current_index(std::size_t index) { current_index = index; }
         auto increment_current_index() { return ++current_index; }
         void set_shrinkable(ShrinkableNode* node) { shrinkable = node; }
@@ -89,6 +119,10 @@ namespace CatchKit::Detail {
         }
         auto add_child(NodeId const& id_to_add) -> ExecutionNode&;
 
+        // Copies this node and all its descendants - or returns nullptr if any can't be copied
+        [[nodiscard]] auto clone_tree( ExecutionNodes* new_container ) const -> std::unique_ptr<ExecutionNode>;
+
+        [[nodiscard]] auto get_name() const -> std::string const& { return id.name; }
         [[nodiscard]] auto get_state() const { return state; }
         [[nodiscard]] auto get_parent() const { return parent; }
         [[nodiscard]] auto get_parent_state() const { return parent ? parent->get_state() : States::None; }
@@ -108,6 +142,8 @@ namespace CatchKit::Detail {
     class ExecutionNodes {
         ExecutionNode root;
         ExecutionNode* current_node;
+        std::optional<PathPartition> partition;
+        std::size_t partitioned_size = 0;
         friend class ExecutionNode;
     public:
         explicit ExecutionNodes(NodeId root_id)
@@ -120,6 +156,20 @@ namespace CatchKit::Detail {
         auto add_node(std::unique_ptr<ExecutionNode>&& child) -> ExecutionNode&;
         auto add_node(NodeId const& id) -> ExecutionNode&;
 
+        // A deep copy, in the same state, or nullptr if any of the nodes can't be copied
+        [[nodiscard]] auto clone() const -> std::unique_ptr<ExecutionNodes>;
+
+        // Given a node from another ExecutionNodes with the same structure (e.g. the one we were cloned from),
+        // finds the node in the same position in this one
+        [[nodiscard]] auto find_corresponding( ExecutionNode const& other_node ) -> ExecutionNode*;
+
+        // The partition is applied to the first node added if it is a generator directly under the root,
+        // as everything else in the test is then nested within it
+        void partition_paths( PathPartition const& paths ) { partition = paths; }
+        [[nodiscard]] auto get_partition() const -> std::optional<PathPartition> const& { return partition; }
+        // How many values the partitioned node iterates over, or 0 if the partition couldn't be applied
+        [[nodiscard]] auto get_partitioned_size() const { return partitioned_size; }
+
         [[nodiscard]] auto& get_root() { return root; }
         [[nodiscard]] auto get_current_node() const { return current_node; }
         [[nodiscard]] auto find_node(NodeId const& id) const -> ExecutionNode* {
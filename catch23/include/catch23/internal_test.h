@@ -7,7 +7,15 @@
 
 #include "test_info.h"
 
-#include <functional>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <source_location>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace CatchKit::Detail {
@@ -16,8 +24,102 @@ namespace CatchKit::Detail {
     template<typename T>
     concept TagConvertible = std::constructible_from<Tag, T>;
 
+    // The body of a test. The TEST macros always give us a plain function pointer, which is called directly.
+    // Any other callable (e.g. a lambda from LOCAL_TEST) is held inline, if it is small enough, or on the heap.
+    // Like std::function, calling it is const, but the callable is not
+    class TestFunction {
+    public:
+        using FunctionPtr = void(*)(Checker&);
+
+    private:
+        static constexpr std::size_t inline_size = 2 * sizeof(void*);
+
+        struct Operations {
+            void (*invoke)( void* callable, Checker& checker );
+            void (*move_to)( void* from, void* to ) noexcept; // leaves from empty
+            void (*destroy)( void* callable ) noexcept;
+        };
+        template<typename F>
+        static constexpr bool fits_inline =
+            sizeof(F) <= inline_size && alignof(F) <= alignof(void*) && std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        static constexpr Operations inline_operations{
+            .invoke = []( void* callable, Checker& checker ) { (*static_cast<F*>(callable))( checker ); },
+            .move_to = []( void* from, void* to ) noexcept {
+                ::new( to ) F( std::move( *static_cast<F*>(from) ) );
+                static_cast<F*>(from)->~F();
+            },
+            .destroy = []( void* callable ) noexcept { static_cast<F*>(callable)->~F(); } };
+
+        template<typename F>
+        static constexpr Operations heap_operations{
+            .invoke = []( void* storage, Checker& checker ) { (**static_cast<F**>(storage))( checker ); },
+            .move_to = []( void* from, void* to ) noexcept { *static_cast<F**>(to) = *static_cast<F**>(from); },
+            .destroy = []( void* storage ) noexcept { delete *static_cast<F**>(storage); } };
+
+        union {
+            FunctionPtr function = nullptr;
+            alignas(void*) std::byte storage[inline_size];
+        };
+        Operations const* operations = nullptr; // nullptr when we're just holding function
+
+        void take( TestFunction& other ) noexcept {
+            operations = std::exchange( other.operations, nullptr );
+            if( operations )
+                operations->move_to( other.storage, storage );
+            else
+                function = other.function;
+            other.function = nullptr;
+        }
+        void reset() noexcept {
+            if( operations )
+                operations->destroy( storage );
+            operations = nullptr;
+            function = nullptr;
+        }
+
+    public:
+        TestFunction() = default;
+        TestFunction( FunctionPtr function ) : function( function ) {} // NOLINT (implicit)
+
+        template<typename F>
+            requires (!std::same_as<std::remove_cvref_t<F>, TestFunction> && std::invocable<std::decay_t<F>&, Checker&>)
+        TestFunction( F&& callable ) { // NOLINT (implicit)
+            using Callable = std::decay_t<F>;
+            if constexpr( std::is_convertible_v<Callable, FunctionPtr> ) {
+                function = callable; // captureless lambdas, etc.
+            }
+            else if constexpr( fits_inline<Callable> ) {
+                ::new( static_cast<void*>( storage ) ) Callable( std::forward<F>( callable ) );
+                operations = &inline_operations<Callable>;
+            }
+            else {
+                ::new( static_cast<void*>( storage ) ) Callable*( new Callable( std::forward<F>( callable ) ) );
+                operations = &heap_operations<Callable>;
+            }
+        }
+
+        TestFunction( TestFunction&& other ) noexcept { take( other ); }
+        auto operator=( TestFunction&& other ) noexcept -> TestFunction& {
+            if( this != &other ) {
+                reset();
+                take( other );
+            }
+            return *this;
+        }
+        ~TestFunction() { reset(); }
+
+        void operator()( Checker& checker ) const {
+            if( !operations ) [[likely]]
+                function( checker );
+            else
+                operations->invoke( const_cast<std::byte*>( storage ), checker ); // NOLINT
+        }
+        explicit operator bool() const { return operations || function; }
+    };
+
     struct Test {
-        using TestFunction = std::function<void(Checker&)>;
         TestFunction test_fun;
         TestInfo test_info;
 
@@ -31,10 +133,78 @@ namespace CatchKit::Detail {
         }
     };
 
+    // Registers a test that is made at runtime
     struct AutoReg {
         explicit AutoReg(Test&& test);
     };
 
+    // The name and tags of a test, when they are all constants, so the test can be indexed (and selected)
+    // without being made
+    struct ConstantTestHeader {
+        std::string_view name;
+        std::span<Tag const> tags;
+    };
+
+    // Strings that are already constants, rather than views onto something that will go away
+    template<typename T>
+    concept StaticString = std::is_convertible_v<T, char const*> || std::same_as<std::remove_cvref_t<T>, std::string_view>;
+
+    // The name and tags, as written in a TEST macro, evaluated (at compile time, where possible) apart from the test
+    template<std::size_t TagCount>
+    struct TestHeader {
+        std::string_view name;
+        std::array<Tag, TagCount> tags;
+        bool only_static_strings = true; // if not, we can't keep it as a constant, as it views temporaries
+
+        template<TagConvertible... T>
+        constexpr auto operator[]( T&&... more_tags ) const -> TestHeader<sizeof...(T)> {
+            return {
+                name,
+                { Tag{ std::forward<T>( more_tags ) }... },
+                only_static_strings && ((StaticString<T> || std::same_as<std::remove_cvref_t<T>, Tag>) && ...) };
+        }
+    };
+    template<typename T = std::string_view>
+    constexpr auto test_header( T&& name = {} ) -> TestHeader<0> {
+        return { name, {}, StaticString<T> };
+    }
+
+    // Only instantiated if make_header() is a constant
+    template<auto make_header>
+    inline constexpr auto test_header_storage = make_header();
+    template<auto make_header>
+    inline constexpr ConstantTestHeader constant_test_header{
+        test_header_storage<make_header>.name, test_header_storage<make_header>.tags };
+
+    // make_header is a lambda that returns a TestHeader. If that can be called at compile time we hold on to it
+    template<auto make_header>
+    consteval auto get_constant_test_header() -> ConstantTestHeader const* {
+        if constexpr( requires { typename std::bool_constant<make_header().only_static_strings>; } ) {
+            if constexpr( make_header().only_static_strings )
+                return &constant_test_header<make_header>;
+        }
+        return nullptr;
+    }
+
+    // Made by the TEST macros as a constant, so it costs nothing at startup.
+    // The Test itself is only made if it is selected to run (or, if its header isn't constant, when the registry
+    // is first used, so its name and tags can be indexed).
+    // Descriptors are laid out back to back in a linker section, so we fix the alignment (which compilers may
+    // otherwise raise for larger globals) to keep the size a multiple of it.
+    // That's 32 bytes where std::source_location is one pointer, and padded up to 64 where it is bigger (e.g. MSVC).
+    // It's the same whether or not the linker section is used, so every translation unit agrees on the layout
+    struct alignas(32) TestDescriptor {
+        auto (*make_test)() -> Test;
+        std::source_location location;
+        ConstantTestHeader const* header = nullptr; // if the name and tags aren't constants
+    };
+    static_assert( sizeof(TestDescriptor) % alignof(TestDescriptor) == 0 );
+
+    // Registers a descriptor where they can't be placed in a linker section (see macros.h)
+    struct DescriptorRegistrar {
+        explicit DescriptorRegistrar( TestDescriptor const& descriptor );
+    };
+
 } // CatchKit::Detail
 
 namespace CatchKit::Tags {
@@ -53,6 +223,12 @@ namespace CatchKit::Tags {
 
     // Tests that always_report will report successful tests regardless of flags
     inline constexpr Tag always_report{"^always_report", Tag::Type::always_report };
+
+    // Tests that run for longer than the time limit are cancelled and reported as failed
+    // (overriding any limit given on the command line)
+    inline auto timeout( std::chrono::milliseconds time_limit ) -> Tag {
+        return Tag{"^timeout", Tag::Type::timeout, false, time_limit };
+    }
 }
 
 #endif // CATCH23_INTERNAL_TEST_H
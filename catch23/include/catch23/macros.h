@@ -14,18 +14,53 @@
 #include "catchkit/internal_macro_utils.h"
 #include "catchkit/macros.h"
 
+// Test registration.
+// Where we can (ELF platforms, with GCC or Clang), each test's descriptor is a constant placed in its own
+// linker section, which the registry walks on first use - so there is no work to do before main.
+// Otherwise (or with address sanitizer, which pads globals), each descriptor is registered by a static object
+#if defined(__ELF__) && defined(__GNUC__) && !defined(__SANITIZE_ADDRESS__) && !defined(CATCH23_CONFIG_NO_TEST_SECTION)
+#  if defined(__has_feature)
+#    if __has_feature(address_sanitizer)
+#      define CATCH23_INTERNAL_NO_TEST_SECTION
+#    endif
+#  endif
+#else
+#  define CATCH23_INTERNAL_NO_TEST_SECTION
+#endif
+
+#ifndef CATCH23_INTERNAL_NO_TEST_SECTION
+#  if defined(__has_attribute) && __has_attribute(retain)
+#    define CATCH23_INTERNAL_TEST_DESCRIPTOR_ATTRIBUTES __attribute__((used, retain, section("catch23_tests")))
+#  else
+#    define CATCH23_INTERNAL_TEST_DESCRIPTOR_ATTRIBUTES __attribute__((used, section("catch23_tests")))
+#  endif
+#  define CATCH23_INTERNAL_REGISTER_TEST_DESCRIPTOR(descriptor)
+#else
+#  define CATCH23_INTERNAL_TEST_DESCRIPTOR_ATTRIBUTES
+#  define CATCH23_INTERNAL_REGISTER_TEST_DESCRIPTOR(descriptor) \
+    CatchKit::Detail::DescriptorRegistrar const test_registrar( descriptor );
+#endif
+
 // Test cases
 #define CATCH23_MAKE_TEST(fname, ...) \
     CatchKit::Detail::Test( &fname, { std::source_location::current()__VA_OPT__(, CATCHKIT_VA_MACRO_HEAD(__VA_ARGS__)) } ) CATCHKIT_VA_MACRO_TAIL(__VA_ARGS__)
 
-#define CATCH23_INTERNAL_TEST2(fname, test_decl) \
+#define CATCH23_MAKE_TEST_HEADER(...) \
+    CatchKit::Detail::get_constant_test_header<[]{ \
+        return CatchKit::Detail::test_header( __VA_OPT__(CATCHKIT_VA_MACRO_HEAD(__VA_ARGS__)) ) CATCHKIT_VA_MACRO_TAIL(__VA_ARGS__); }>()
+
+#define CATCH23_INTERNAL_TEST2(fname, test_decl, header_decl) \
     static void fname(CatchKit::Checker&); \
-    namespace{ namespace CATCHKIT_INTERNAL_UNIQUE_NAME(reg_ns) { using namespace CatchKit::Tags; CatchKit::Detail::AutoReg auto_registrar ( test_decl ); } } /* NOLINT */ \
+    namespace{ namespace CATCHKIT_INTERNAL_UNIQUE_NAME(reg_ns) { using namespace CatchKit::Tags; /* NOLINT */ \
+        CATCH23_INTERNAL_TEST_DESCRIPTOR_ATTRIBUTES constinit CatchKit::Detail::TestDescriptor const test_descriptor{ \
+            +[]() -> CatchKit::Detail::Test { return test_decl; }, std::source_location::current(), header_decl }; \
+        CATCH23_INTERNAL_REGISTER_TEST_DESCRIPTOR( test_descriptor ) } } /* NOLINT */ \
     CATCHKIT_WARNINGS_UNSCOPED_SUPPRESS_UNUSED_PARAMETER \
     CATCHKIT_WARNINGS_UNSCOPED_SUPPRESS_SHADOW \
     static void fname(CatchKit::Checker& checker )
 
-#define CATCH23_INTERNAL_TEST(fname, ... ) CATCH23_INTERNAL_TEST2( fname, CATCH23_MAKE_TEST(fname, __VA_ARGS__) )
+#define CATCH23_INTERNAL_TEST(fname, ... ) \
+    CATCH23_INTERNAL_TEST2( fname, CATCH23_MAKE_TEST(fname, __VA_ARGS__), CATCH23_MAKE_TEST_HEADER(__VA_ARGS__) )
 
 #define TEST(...) CATCH23_INTERNAL_TEST( CATCHKIT_INTERNAL_UNIQUE_NAME(catch23_test_), __VA_ARGS__ )
 
@@ -48,7 +83,9 @@
 // Catch2 compatibility
 #define CATCH23_INTERNAL_MAKE_TEST_LEGACY(fname, ...) \
     CatchKit::Detail::Test( &fname, CatchKit::Detail::make_test_info( std::source_location::current() __VA_OPT__(, __VA_ARGS__ ) ) )
-#define CATCH23_INTERNAL_TEST_LEGACY(fname, ... ) CATCH23_INTERNAL_TEST2( fname, CATCH23_INTERNAL_MAKE_TEST_LEGACY(fname, __VA_ARGS__ ) )
+// (tag specs are parsed at runtime, so these tests are always made up front)
+#define CATCH23_INTERNAL_TEST_LEGACY(fname, ... ) \
+    CATCH23_INTERNAL_TEST2( fname, CATCH23_INTERNAL_MAKE_TEST_LEGACY(fname, __VA_ARGS__ ), nullptr )
 
 #define TEST_CASE(...) CATCH23_INTERNAL_TEST_LEGACY(CATCHKIT_INTERNAL_UNIQUE_NAME(catch23_test), __VA_ARGS__)
 
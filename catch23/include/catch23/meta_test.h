@@ -44,12 +44,17 @@ namespace CatchKit {
             results.emplace_back(context, assertion_info);
         }
         void on_shrink_start() override { /* no impl */ }
-        void on_shrink_found( std::vector<std::string> const&, int ) override { /* no impl */ }
-        void on_no_shrink_found( int ) override { /* no impl */ }
+        void on_shrink_found( std::vector<std::string> const& values, int shrinks ) override {
+            shrunk_values = values;
+            shrink_count = shrinks;
+        }
+        void on_no_shrink_found( int shrinks ) override { shrink_count = shrinks; }
         void on_shrink_result( ResultType, int ) override { /* no impl */ }
         void on_shrink_end() override { /* no impl */ }
 
         std::vector<FullAssertionInfo> results;
+        std::vector<std::string> shrunk_values;
+        int shrink_count = 0;
     };
 
     struct MetaTestResults {
@@ -82,7 +87,7 @@ namespace CatchKit {
         auto run_test_by_name( std::string const& name_to_find ) && -> MetaTestResults;
 
         friend auto operator << ( MetaTestRunner&& runner, std::invocable<Checker&> auto const& test_fun ) {
-            return std::move(runner).run(Detail::Test{test_fun, {runner.location, std::move(runner.name)}});
+            return std::move(runner).run(Detail::Test{test_fun, {runner.location, runner.name}});
         }
     };
 
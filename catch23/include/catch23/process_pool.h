@@ -0,0 +1,45 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_PROCESS_POOL_H
+#define CATCH23_PROCESS_POOL_H
+
+#include "internal_test.h"
+#include "reporter.h"
+#include "catchkit/stringify.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    using TestTimedCallback = std::function<void(Test const&, std::chrono::nanoseconds)>;
+
+    struct ProcessPoolOptions {
+        int worker_count = 1;
+        std::chrono::milliseconds default_time_limit{}; // for tests without a timeout tag (0 for none)
+        std::size_t shrink_batch_size = 1; // how many shrink candidates each worker tries at once (see --shrink-batch)
+        StringifyLimits stringify_limits; // how much of each value the workers stringify
+        TestTimedCallback on_test_timed; // if supplied, called with the wall time of each test, as seen from this process
+        std::function<bool()> should_stop; // if supplied, checked after each test is reported, to end the run early
+    };
+
+    [[nodiscard]] auto process_pool_is_supported() -> bool;
+
+    // Runs the tests in a pool of worker processes, forked from this one (so sharing the already built registry).
+    // Workers are handed tests one at a time, and stream their reporter events back, which are then forwarded
+    // on to reporter one test at a time.
+    // If a worker dies, the test it was running is reported as failed and the worker is replaced.
+    // A worker whose test runs past its time limit is killed, and treated the same way.
+    // When stopping early, tests still running are killed without being reported
+    void run_tests_in_process_pool(
+        std::vector<Test const*> const& tests,
+        Reporter& reporter,
+        ProcessPoolOptions const& options );
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_PROCESS_POOL_H
@@ -32,6 +32,11 @@ namespace CatchKit::Detail {
         void reset() {
             mt.seed(seed);
         }
+        void reseed(unsigned int new_seed) {
+            seed = new_seed;
+            reset();
+        }
+        [[nodiscard]] auto get_seed() const { return seed; }
 
         // Returns a number between from and to, inclusive
         template<IsBuiltInNumeric NumberT>
@@ -0,0 +1,53 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_RECORDING_REPORTER_H
+#define CATCH23_RECORDING_REPORTER_H
+
+#include "reporter.h"
+
+#include <functional>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // Records reporter events so they can be replayed, in order, into another reporter later.
+    // Used to keep each test's output contiguous when tests are run concurrently
+    class RecordingReporter : public Reporter {
+        ReportOn what_to_report_on;
+        std::vector<std::function<void(Reporter&)>> events;
+
+    public:
+        explicit RecordingReporter( ReportOn what_to_report_on )
+        :   what_to_report_on( what_to_report_on )
+        {}
+
+        // Replays all the recorded events into target, then forgets them
+        void replay_into( Reporter& target );
+        // Forgets the recorded events without replaying them
+        void discard() { events.clear(); }
+
+        [[nodiscard]] auto report_on_what() const -> ReportOn override {
+            return what_to_report_on;
+        }
+
+        void on_test_run_start() override;
+        void on_test_run_end() override;
+
+        void on_test_start( TestInfo const& test_info ) override;
+        void on_test_end( TestInfo const& test_info, Counters const& assertions ) override;
+
+        void on_assertion_start( AssertionContext const& context ) override;
+        void on_assertion_end( AssertionContext const& context, AssertionInfo const& assertion_info ) override;
+
+        void on_shrink_start() override;
+        void on_shrink_found( std::vector<std::string> const& values, int shrinks ) override;
+        void on_no_shrink_found( int shrinks ) override;
+        void on_shrink_result( ResultType result, int shrinks_so_far ) override;
+        void on_shrink_end() override;
+    };
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_RECORDING_REPORTER_H
@@ -14,6 +14,7 @@
 #include "catchkit/report_on.h"
 #include "catchkit/captured_variable.h"
 
+#include <string>
 #include <vector>
 
 namespace CatchKit {
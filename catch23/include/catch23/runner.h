@@ -8,11 +8,18 @@
 #include <algorithm>
 
 #include "config.h"
+#include "duration_history.h"
 #include "print.h"
 #include "test_registry.h"
 #include "test.h"
 #include "reporter.h"
+#include "tallying_reporter.h"
 #include "test_result_handler.h"
+#include "watchdog.h"
+
+#include <atomic>
+#include <optional>
+#include <stdexcept>
 
 namespace CatchKit::Detail {
 
@@ -20,45 +27,72 @@ namespace CatchKit::Detail {
     concept range_of = std::ranges::range<R> &&
                        std::same_as<std::ranges::range_value_t<R>, T>;
 
+    // Runs every path through the test (or just those in the partition), reporting through the supplied handler
+    void run_test_paths( Test const& test, TestResultHandler& test_handler, std::optional<PathPartition> const& partition = {} );
+
+    // Runs the paths through the test across worker_count threads, if the test starts with a generator.
+    // Results from each thread are reported together, after those from this one
+    void run_test_paths_in_parallel( Test const& test, TestResultHandler& test_handler, std::size_t worker_count );
+
     class TestRunner {
+        TallyingReporter tally; // between the handler(s) and the real reporter, so we know when to abort
         TestResultHandler result_handler;
         Config config;
+        std::optional<TestFilter> filter; // if any tests or tags were specified
+        DurationHistory duration_history;
+        DurationHistory shard_history; // never saved, so every shard that loads the same file balances the same way
+        Watchdog watchdog;
+        std::atomic<bool> aborting = false;
 
         void run_tests( std::vector<Test const*> const& tests_to_run, bool soloing );
+        void run_tests_in_parallel( std::vector<Test const*> const& tests_to_run );
+        [[nodiscard]] auto select_shard( std::vector<Test const*> const& tests ) const -> std::vector<Test const*>;
+        static void order_longest_first( std::vector<Test const*>& tests, DurationHistory const& history );
+        void record_duration( Test const& test, std::chrono::nanoseconds duration );
+        // Resets handler's cancellation state, then, if the test has a time limit,
+        // arranges for it to be cancelled if it is still running when the returned watch ends
+        [[nodiscard]] auto watch_for_timeout( Test const& test, TestResultHandler& handler ) -> Watchdog::Watch;
+        // Checks the tally against --abort-after, setting aborting if it has been reached
+        auto check_for_abort() -> bool;
 
     public:
         explicit TestRunner( Reporter& reporter, Config config )
-        :   result_handler(reporter),
+        :   tally(reporter),
+            result_handler(tally),
             config(std::move(config))
-        {}
+        {
+            if( !this->config.tests_or_tags.empty() ) {
+                auto parsed = TestFilter::parse( this->config.tests_or_tags );
+                if( !parsed )
+                    throw std::invalid_argument( parsed.error() );
+                filter = std::move( *parsed );
+            }
+            result_handler.set_shrink_batch_size( static_cast<std::size_t>(this->config.shrink_batch) );
+            result_handler.set_stringify_limits( {
+                .max_elements = static_cast<std::size_t>(this->config.max_elements),
+                .max_chars = static_cast<std::size_t>(this->config.max_chars),
+                .max_depth = static_cast<std::size_t>(this->config.max_depth) } );
+            if( !this->config.durations_file.empty() )
+                duration_history.load( this->config.durations_file );
+            // Falling back to hashing here could leave this shard disagreeing with others that did load it
+            if( !this->config.shard_durations_file.empty() && !shard_history.load( this->config.shard_durations_file ) )
+                throw std::invalid_argument( "Unable to read test durations for balancing shards from " + this->config.shard_durations_file );
+        }
 
         void run_test( Test const& test );
 
         void run_tests( TestRegistry const& tests );
 
         void run_tests( range_of<Test> auto& tests ) {
-            static auto to_ptr = std::views::transform(
-                []( Test const& test ) { return &test; });
-
-            auto soloed = tests
-                | std::views::filter( []( Test const& test ) {
-                        return test.test_info.has_tag_type(Tag::Type::solo);
-                    })
-                | to_ptr
+            auto all_tests = tests
+                | std::views::transform( []( Test const& test ) { return &test; } )
                 | std::ranges::to<std::vector>();
-            if( !soloed.empty() )
-                return run_tests( soloed, true );
-
-            auto not_muted = tests
-                | std::views::filter([this]( Test const& test ) { return should_test_run(test);})
-                | to_ptr
-                | std::ranges::to<std::vector>();
-
-            return run_tests( not_muted, false );
+            TestIndex index( all_tests );
+            run_tests( get_tests( all_tests, select_tests( index ) ), !index.get_soloed().empty() );
         }
 
-        [[nodiscard]] auto should_test_run( Test const& test ) const -> bool;
-        [[nodiscard]] auto matches_config( Test const& test ) const -> bool;
+        // Soloed tests, if there are any, otherwise those matching the filter (or just those not muted)
+        [[nodiscard]] auto select_tests( TestIndex const& index ) const -> TestSet;
     };
 
 } // namespace CatchKit::Detail
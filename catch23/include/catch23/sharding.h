@@ -0,0 +1,23 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_SHARDING_H
+#define CATCH23_SHARDING_H
+
+#include "test_info.h"
+
+#include <cstdint>
+
+namespace CatchKit::Detail {
+
+    // A hash of the test's name and the file it lives in (but not the line, which moves around as code is edited).
+    // This is stable across builds and platforms, so can be used to partition tests or as a key for persisted data
+    [[nodiscard]] auto hash_test_identity( TestInfo const& test_info ) -> std::uint64_t;
+
+    // Which of shard_count shards this test belongs in (in the range [0, shard_count) )
+    [[nodiscard]] auto shard_for_test( TestInfo const& test_info, int shard_count ) -> int;
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_SHARDING_H
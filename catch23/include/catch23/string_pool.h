@@ -0,0 +1,59 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_STRING_POOL_H
+#define CATCH23_STRING_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // Holds one copy of each distinct string it is given, packed together in large blocks.
+    // Strings are never removed, so the views it hands out remain valid for as long as the pool.
+    // Safe to use from multiple threads
+    class StringPool {
+        struct Slot {
+            std::size_t hash = 0;
+            std::string_view str; // data() is null if the slot is empty
+        };
+        static constexpr std::size_t block_size = 16 * 1024;
+
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* next_char = nullptr;
+        std::size_t chars_left = 0;
+        std::vector<Slot> slots; // open addressed (with linear probing), always a power of two in size
+        std::size_t count = 0;
+
+        [[nodiscard]] auto find_slot( std::size_t hash, std::string_view str ) const -> std::size_t;
+        auto copy_in( std::string_view str ) -> std::string_view;
+        void grow();
+
+    public:
+        StringPool();
+
+        // Returns the pool's copy of str, adding it if it's not already there
+        auto intern( std::string_view str ) -> std::string_view;
+
+        // Returns the pool's copy of str, if it has one
+        [[nodiscard]] auto find( std::string_view str ) const -> std::optional<std::string_view>;
+
+        [[nodiscard]] auto size() const -> std::size_t;
+    };
+
+    // The pool used for test names and tags
+    auto get_string_pool() -> StringPool&;
+
+    inline auto intern( std::string_view str ) -> std::string_view {
+        return get_string_pool().intern( str );
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_STRING_POOL_H
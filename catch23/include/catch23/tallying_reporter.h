@@ -0,0 +1,47 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_TALLYING_REPORTER_H
+#define CATCH23_TALLYING_REPORTER_H
+
+#include "reporter.h"
+
+namespace CatchKit::Detail {
+
+    // Passes all events on to another reporter, keeping a tally of test results on the way through
+    // (counted the same way as the console reporter's totals). Not thread-safe, so when tests run
+    // concurrently it should only see their replayed events
+    class TallyingReporter : public Reporter {
+        Reporter& target;
+        Counters test_totals;
+
+    public:
+        explicit TallyingReporter( Reporter& target ) : target( target ) {}
+
+        [[nodiscard]] auto get_target() const -> Reporter& { return target; }
+        [[nodiscard]] auto get_test_totals() const -> Counters const& { return test_totals; }
+
+        [[nodiscard]] auto report_on_what() const -> ReportOn override { return target.report_on_what(); }
+
+        void on_test_run_start() override { target.on_test_run_start(); }
+        void on_test_run_end() override { target.on_test_run_end(); }
+
+        void on_test_start( TestInfo const& test_info ) override { target.on_test_start( test_info ); }
+        void on_test_end( TestInfo const& test_info, Counters const& assertions ) override;
+
+        void on_assertion_start( AssertionContext const& context ) override { target.on_assertion_start( context ); }
+        void on_assertion_end( AssertionContext const& context, AssertionInfo const& assertion_info ) override {
+            target.on_assertion_end( context, assertion_info );
+        }
+
+        void on_shrink_start() override { target.on_shrink_start(); }
+        void on_shrink_found( std::vector<std::string> const& values, int shrinks ) override { target.on_shrink_found( values, shrinks ); }
+        void on_no_shrink_found( int shrinks ) override { target.on_no_shrink_found( shrinks ); }
+        void on_shrink_result( ResultType result, int shrinks_so_far ) override { target.on_shrink_result( result, shrinks_so_far ); }
+        void on_shrink_end() override { target.on_shrink_end(); }
+    };
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_TALLYING_REPORTER_H
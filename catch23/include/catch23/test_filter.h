@@ -0,0 +1,62 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_TEST_FILTER_H
+#define CATCH23_TEST_FILTER_H
+
+#include "test_index.h"
+
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // Matches text against a pattern where * matches any sequence of characters (including none)
+    [[nodiscard]] auto wildcard_match( std::string_view pattern, std::string_view text ) -> bool;
+
+    // Selects tests using the same sort of specs as Catch2:
+    //   name          tests with this name. Unquoted names may contain spaces (but are trimmed)
+    //   "name"        the same, but may contain , [ or ~ (or use \ to escape single characters)
+    //   [tag]         tests with this tag
+    //   file.cpp:42   the test in a file ending file.cpp that is declared on, or most recently before, line 42
+    //   ~             negates whatever follows it
+    // Names and tags may include * wildcards. Patterns next to each other must all match (and);
+    // patterns separated by , are alternatives (or). e.g. "[fast]~[flaky],startup*" runs all fast tests that
+    // aren't flaky, as well as any tests whose name starts with "startup".
+    // Muted tests are only selected by an alternative with at least one pattern that isn't negated
+    class TestFilter {
+    public:
+        struct Pattern {
+            enum class Kind { Name, Tag, Location };
+            Kind kind;
+            std::string text; // name, tag or file name
+            std::uint32_t line = 0; // only for Location
+            bool negated = false;
+        };
+        using Conjunction = std::vector<Pattern>; // all must match
+
+    private:
+        std::vector<Conjunction> alternatives; // any may match
+
+        [[nodiscard]] static auto select( Pattern const& pattern, TestIndex const& index ) -> TestSet;
+
+    public:
+        // Returns a description of the problem if the spec can't be parsed
+        [[nodiscard]] static auto parse( std::string_view spec ) -> std::expected<TestFilter, std::string>;
+
+        [[nodiscard]] auto get_alternatives() const -> std::vector<Conjunction> const& { return alternatives; }
+
+        [[nodiscard]] auto select( TestIndex const& index ) const -> TestSet;
+    };
+
+} // namespace CatchKit::Detail
+
+namespace CatchKit {
+    using Detail::TestFilter;
+}
+
+#endif // CATCH23_TEST_FILTER_H
@@ -0,0 +1,115 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_TEST_INDEX_H
+#define CATCH23_TEST_INDEX_H
+
+#include "internal_test.h"
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <source_location>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // A set of tests, as one bit per position in a TestIndex
+    class TestSet {
+        std::vector<std::uint64_t> words;
+        std::size_t size = 0;
+
+        void clear_unused_bits();
+    public:
+        TestSet() = default;
+        explicit TestSet( std::size_t size, bool all = false );
+
+        void insert( std::size_t index ) { words[index / 64] |= std::uint64_t{1} << (index % 64); }
+        [[nodiscard]] auto contains( std::size_t index ) const -> bool { return (words[index / 64] >> (index % 64)) & 1; }
+        [[nodiscard]] auto count() const -> std::size_t;
+        [[nodiscard]] auto empty() const -> bool;
+        [[nodiscard]] auto capacity() const { return size; }
+
+        auto operator &= ( TestSet const& other ) -> TestSet&;
+        auto operator |= ( TestSet const& other ) -> TestSet&;
+        auto operator -= ( TestSet const& other ) -> TestSet&;
+
+        // Calls fn with the index of each test in the set, in order
+        void for_each( auto&& fn ) const {
+            for( std::size_t word_index = 0; word_index < words.size(); ++word_index ) {
+                for( auto word = words[word_index]; word != 0; word &= word - 1 )
+                    fn( word_index * 64 + static_cast<std::size_t>( std::countr_zero( word ) ) );
+            }
+        }
+    };
+
+    // What the index needs to know about a test. These are views onto a Test's info, or onto the constants in
+    // its descriptor (so tests can be indexed, and selected, before they have been made)
+    struct IndexedTest {
+        std::string_view name;
+        std::span<Tag const> tags;
+        std::source_location location;
+
+        [[nodiscard]] auto has_tag_type( Tag::Type tag_type ) const -> bool;
+    };
+
+    // Indexes a list of tests by name, tag and file, so subsets can be selected
+    // without rescanning all the tests and their tags each time.
+    // Names and tags are views onto the (interned, or literal) strings in the tests, so nothing is copied.
+    // Tests are identified by their position in the list, so whatever holds them maps those back to the tests
+    class TestIndex {
+    public:
+        using TagId = std::uint32_t;
+
+    private:
+        struct NameSlot {
+            std::uint32_t hash = 0; // the low bits of the name's hash, to skip most mismatches without a lookup
+            std::uint32_t first_test = 0; // index + 1 of the first test with the name, or 0 if the slot is empty
+            std::uint32_t last_test = 0;
+        };
+
+        std::vector<IndexedTest> tests;
+        std::unordered_map<std::string_view, TagId> tag_ids;
+        std::vector<std::string_view> tag_names; // indexed by TagId
+        std::vector<TestSet> tests_by_tag; // indexed by TagId
+        std::vector<NameSlot> name_slots; // open addressed (with linear probing), a power of two in size
+        std::vector<std::uint32_t> next_with_same_name; // per test: index + 1 of the next test with its name, or 0
+        std::unordered_map<std::string_view, std::vector<std::size_t>> tests_by_file; // each in line order
+        TestSet muted;
+        TestSet soloed;
+
+        auto intern_tag( std::string_view name ) -> TagId;
+        void index_name( std::size_t index );
+        [[nodiscard]] auto first_with_name( std::string_view name ) const -> std::uint32_t;
+
+    public:
+        TestIndex() = default;
+        explicit TestIndex( std::vector<IndexedTest> tests );
+        explicit TestIndex( std::span<Test const* const> tests ); // which must outlive the index (and not move)
+
+        [[nodiscard]] auto size() const { return tests.size(); }
+        [[nodiscard]] auto get_test( std::size_t index ) const -> IndexedTest const& { return tests[index]; }
+
+        [[nodiscard]] auto all() const { return TestSet( tests.size(), true ); }
+        [[nodiscard]] auto get_muted() const -> TestSet const& { return muted; }
+        [[nodiscard]] auto get_soloed() const -> TestSet const& { return soloed; }
+
+        [[nodiscard]] auto find_tag( std::string_view name ) const -> std::optional<TagId>;
+        [[nodiscard]] auto get_tag_names() const -> std::vector<std::string_view> const& { return tag_names; }
+        [[nodiscard]] auto with_tag( TagId id ) const -> TestSet const& { return tests_by_tag[id]; }
+        [[nodiscard]] auto with_tag( std::string_view name ) const -> TestSet;
+        [[nodiscard]] auto with_name( std::string_view name ) const -> TestSet;
+        [[nodiscard]] auto find_by_name( std::string_view name ) const -> std::optional<std::size_t>; // the first, if there's more than one
+        [[nodiscard]] auto get_files() const -> std::unordered_map<std::string_view, std::vector<std::size_t>> const& { return tests_by_file; }
+    };
+
+    // The tests at the positions in the set, from the list that was indexed
+    [[nodiscard]] auto get_tests( std::span<Test const* const> tests, TestSet const& selected ) -> std::vector<Test const*>;
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_TEST_INDEX_H
@@ -5,8 +5,13 @@
 #ifndef CATCH23_TEST_INFO_H
 #define CATCH23_TEST_INFO_H
 
+#include "string_pool.h"
+
+#include <chrono>
+#include <optional>
 #include <source_location>
-#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace CatchKit {
@@ -19,24 +24,54 @@ namespace CatchKit {
             may_fail, // If test fails, don't count it as a failed run overall
             should_fail, // If test fails count it as a pass. If it passes count as a failure.
             always_report, // Report all tests, even successful ones, regardless of flags
+            timeout, // Fail the test if it runs for longer than time_limit
         };
-        std::string name;
+        std::string_view name; // interned (or, for constant tags, a literal), so it outlives the tag
         Type type = Type::normal;
         bool ignored = false; // This means "pretend this tag doesn't exist" and is set by !
+        std::chrono::milliseconds time_limit = {}; // Only used by timeout tags
+
+        constexpr Tag( std::string_view name, Type type = Type::normal, bool ignored = false, std::chrono::milliseconds time_limit = {} )
+        :   name( intern_if_runtime( name ) ),
+            type( type ),
+            ignored( ignored ),
+            time_limit( time_limit )
+        {}
+
+        constexpr auto operator!() const -> Tag {
+            return Tag{name, type, !ignored, time_limit};
+        }
 
-        auto operator!() const -> Tag {
-            return Tag{name, type, !ignored};
+    private:
+        // Names of constant tags can only be literals, which already live forever
+        static constexpr auto intern_if_runtime( std::string_view name ) -> std::string_view {
+            if consteval {
+                return name;
+            }
+            else {
+                return Detail::intern( name );
+            }
         }
     };
 
     struct TestInfo {
         std::source_location location;
-        std::string name = {};
-        std::vector<Tag> tags = {};
+        std::string_view name; // interned, so shared by all copies (and tests with the same name)
+        std::vector<Tag> tags;
+
+        TestInfo() = default;
+        TestInfo( std::source_location location, std::string_view name = {}, std::vector<Tag> tags = {} )
+        :   location( location ),
+            name( Detail::intern( name ) ),
+            tags( std::move( tags ) )
+        {}
 
         [[nodiscard]] auto has_tag_type(Tag::Type tag_type) const -> bool;
         [[nodiscard]] auto should_fail() const -> bool;
         [[nodiscard]] auto may_fail() const -> bool;
+
+        // The limit from a timeout tag, if there is one, otherwise default_limit (where 0 means no limit)
+        [[nodiscard]] auto time_limit( std::chrono::milliseconds default_limit = {} ) const -> std::optional<std::chrono::milliseconds>;
     };
 
 } // namespace CatchKit
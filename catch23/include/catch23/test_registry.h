@@ -6,23 +6,50 @@
 #define CATCH23_TEST_REGISTRY_H
 
 #include "internal_test.h"
+#include "test_filter.h"
+#include "test_index.h"
 
-#include <vector>
-#include <unordered_map>
 #include <generator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
 
 namespace CatchKit::Detail {
 
+    // Tests whose descriptors have constant headers are indexed from those, and only made when they are first
+    // asked for (so a filtered run doesn't make tests it will never run). The rest are made up front
     class TestRegistry {
-        std::vector<Test> all_tests;
-        std::unordered_map<std::string, std::size_t> tests_by_name;
+        struct Entry {
+            TestDescriptor const* descriptor = nullptr; // if the test hasn't been made yet
+            std::optional<Test> test;
+        };
+        mutable std::vector<Entry> entries; // never added to, or removed from, after construction
+        TestIndex index; // views the descriptors' constants, or the tests' info
+        mutable std::mutex making_tests;
+
+        auto get_test( std::size_t index_of_test ) const -> Test const&;
+
     public:
         explicit TestRegistry( std::vector<Test>&& tests );
+        TestRegistry( std::span<TestDescriptor const* const> descriptors, std::vector<Test>&& tests ); // in that order
+
+        // The index (and any tests already handed out) point into the entries, so it can't be copied.
+        // Nor moved: tests may be made (under the mutex) while others are being run, so it stays where it is
+        TestRegistry( TestRegistry const& ) = delete;
+        auto operator=( TestRegistry const& ) -> TestRegistry& = delete;
+        TestRegistry( TestRegistry&& ) = delete;
+        auto operator=( TestRegistry&& ) -> TestRegistry& = delete;
+
+        auto get_index() const -> TestIndex const& { return index; }
 
-        auto get_all_tests() const -> std::vector<Test> const& {
-            return all_tests;
+        // Makes any of the selected tests that haven't been made yet
+        auto get_tests( TestSet const& selected ) const -> std::vector<Test const*>;
+        auto select( TestFilter const& filter ) const -> std::vector<Test const*> {
+            return get_tests( filter.select( index ) );
         }
-        auto find_test_by_name( std::string const& name ) const -> Test const*;
+        auto find_test_by_name( std::string_view name ) const -> Test const*;
 
         auto find_tests_by_tag( std::string tag_name ) const -> std::generator<Test const*>;
         auto find_all_tests_by_tag( std::string tag_name ) const {
@@ -31,6 +58,7 @@ namespace CatchKit::Detail {
     };
 
     void register_test( Test&& test );
+    void register_test_descriptor( TestDescriptor const& descriptor );
     auto get_test_registry() -> TestRegistry const&;
 
 } // namespace CatchKit
@@ -11,6 +11,10 @@
 #include "adjusted_result.h"
 
 #include "catchkit/result_handler.h"
+#include "catchkit/stringify.h"
+
+#include <atomic>
+#include <chrono>
 
 namespace CatchKit::Detail
 {
@@ -18,6 +22,12 @@ namespace CatchKit::Detail
 
     enum class ShrinkingMode { Normal, Shrinking, Shrunk, NotShrunk };
 
+    enum class CancellationReason {
+        None,
+        TimedOut, // reported as a failure
+        Aborted // the run is stopping early, so nothing more is reported (and it can't be reset)
+    };
+
     class TestResultHandler : public ResultHandler {
         Reporter& reporter;
         std::optional<AssertionContext> current_context;
@@ -28,8 +38,24 @@ namespace CatchKit::Detail
 
         std::vector<VariableCaptureRef*> variable_captures;
         Counters assertions;
+
         ShrinkingMode shrinking_mode = ShrinkingMode::Normal;
         int shrink_count = 0;
+        std::size_t shrink_batch_size = 1;
+        StringifyLimits stringify_limits;
+
+        // Cancellation may be requested from another thread, and is acted on at the next assertion.
+        // Handlers for helper threads follow the cancellation of the handler they are helping
+        std::atomic<CancellationReason> cancellation{ CancellationReason::None };
+        std::atomic<CancellationReason> const* followed_cancellation = &cancellation;
+        std::atomic<bool> not_cancelled{ true }; // the same, as a flag the Checker can see (to stop fast passes)
+        std::atomic<bool> const* followed_not_cancelled = &not_cancelled;
+        mutable bool cut_short = false; // cancellation was seen while running the current test, so some of it was skipped
+        std::chrono::milliseconds time_limit{};
+        std::source_location last_assertion_location;
+
+        [[noreturn]] void cancel_test();
+        void report_timeout();
 
     public:
         explicit TestResultHandler(Reporter& reporter);
@@ -41,12 +67,18 @@ namespace CatchKit::Detail
 
         void on_assertion_start( ResultDisposition result_disposition, AssertionContext const& context ) override;
         [[nodiscard]] auto on_assertion_result( ResultType result ) -> ResultDetailNeeded override;
-        void on_assertion_result_detail( ExpressionInfo const& expression_info, std::string_view message ) override;
+        void on_assertion_result_detail( ExpressionInfo&& expression_info, std::string_view message ) override;
         void on_assertion_end() override;
+        void on_fast_passes( std::size_t count ) override;
+
+        // For Checker::fast_pass. Null if we need to see every passing assertion of the current test
+        [[nodiscard]] auto get_fast_pass_flag() const -> std::atomic<bool> const*;
 
         void on_shrink_start();
         void on_shrink_found( std::vector<std::string> const& values );
         void on_shrink_end();
+        // Counts (and reports) the result of an assertion made while trying a shrink candidate
+        void record_shrink_result( ResultType result );
 
         void add_variable_capture( VariableCaptureRef* capture ) override;
         void remove_variable_capture( VariableCaptureRef* capture ) override;
@@ -59,6 +91,41 @@ namespace CatchKit::Detail
         [[nodiscard]] auto get_last_known_location() const -> std::source_location;
 
         void set_execution_nodes( ExecutionNodes* nodes ) { execution_nodes = nodes; }
+
+        // How many shrink candidates to try at once (each on its own thread)
+        [[nodiscard]] auto get_shrink_batch_size() const { return shrink_batch_size; }
+        void set_shrink_batch_size( std::size_t size ) { shrink_batch_size = size; }
+
+        // How much of each value is stringified, on whichever thread the test is running on
+        [[nodiscard]] auto get_stringify_limits() const -> StringifyLimits const& { return stringify_limits; }
+        void set_stringify_limits( StringifyLimits const& limits ) { stringify_limits = limits; }
+
+        // For the handlers of helper threads, so they run the test the same way as the handler they're helping
+        void use_settings_of( TestResultHandler const& other ) {
+            shrink_batch_size = other.shrink_batch_size;
+            stringify_limits = other.stringify_limits;
+        }
+
+        // Thread-safe. The test is cancelled (and, if timed out, reported as failed) at its next assertion.
+        // Has no effect if cancellation has already been requested (unless we are now aborting)
+        void request_cancellation( CancellationReason reason );
+        void reset_cancellation( std::chrono::milliseconds new_time_limit = {} );
+        void follow_cancellation_of( TestResultHandler const& other ) {
+            followed_cancellation = other.followed_cancellation;
+            followed_not_cancelled = other.followed_not_cancelled;
+        }
+        [[nodiscard]] auto get_cancellation_reason() const -> CancellationReason {
+            return followed_cancellation->load( std::memory_order_acquire );
+        }
+        // Only called from the thread running the test: seeing a cancellation means the test stops short of where it would have
+        [[nodiscard]] auto is_cancelled() const -> bool {
+            if( get_cancellation_reason() == CancellationReason::None )
+                return false;
+            cut_short = true;
+            return true;
+        }
+        // Whether the current test was stopped early by a cancellation (rather than one arriving after it had finished)
+        [[nodiscard]] auto was_cut_short() const -> bool { return cut_short; }
     };
 
     auto get_execution_nodes_from_result_handler(ResultHandler& handler) -> ExecutionNodes&;
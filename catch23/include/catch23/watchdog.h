@@ -0,0 +1,65 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCH23_WATCHDOG_H
+#define CATCH23_WATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace CatchKit::Detail {
+
+    // Calls back when a deadline passes, unless the watch is cancelled (or destroyed) first.
+    // A single thread serves all watches, and is only started when the first one is made.
+    // Callbacks are called with the watchdog's lock held, so must be short (e.g. setting a flag)
+    class Watchdog {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        class [[nodiscard]] Watch {
+            Watchdog* watchdog = nullptr;
+            std::uint64_t id = 0;
+        public:
+            Watch() = default;
+            Watch( Watchdog& watchdog, std::uint64_t id ) : watchdog( &watchdog ), id( id ) {}
+            Watch( Watch&& other ) noexcept;
+            auto operator=( Watch&& other ) noexcept -> Watch&;
+            ~Watch();
+
+            // Once this returns the callback is guaranteed not to be called (or still running)
+            void cancel();
+        };
+
+    private:
+        struct Deadline {
+            Clock::time_point expires_at;
+            std::function<void()> on_expiry;
+        };
+        std::mutex mutex;
+        std::condition_variable_any deadlines_changed;
+        std::map<std::uint64_t, Deadline> deadlines;
+        std::uint64_t next_id = 1;
+        std::uint64_t generation = 0; // bumped whenever the deadlines change
+        std::jthread thread; // last, so it is stopped before the rest is destroyed
+
+        void watch_deadlines( std::stop_token stop );
+        void cancel( std::uint64_t id );
+
+    public:
+        Watchdog() = default;
+        Watchdog( Watchdog const& ) = delete;
+        auto operator=( Watchdog const& ) = delete;
+
+        auto watch( Clock::duration time_limit, std::function<void()> on_expiry ) -> Watch;
+    };
+
+} // namespace CatchKit::Detail
+
+#endif // CATCH23_WATCHDOG_H
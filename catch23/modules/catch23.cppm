@@ -27,6 +27,8 @@ module;
 #include "catch23/meta_test.h"
 #include "catch23/adjusted_result.h"
 #include "catch23/generator_node.h"
+#include "catch23/sharding.h"
+#include "catch23/test_filter.h"
 
 export module catch23;
 
@@ -35,6 +37,8 @@ export import catchkit;
 
 export namespace CatchKit {
     using CatchKit::MetaTestRunner;
+    using CatchKit::MetaTestReporter;
+    using CatchKit::Config;
     using CatchKit::Tag;
 
     using Detail::TestRunner;
@@ -52,6 +56,7 @@ export namespace CatchKit::Tags {
     using Tags::may_fail;
     using Tags::should_fail;
     using Tags::always_report;
+    using Tags::timeout;
 }
 
 export namespace CatchKit::Generators {
@@ -69,10 +74,31 @@ export namespace CatchKit::Detail::Charsets {
 
 export namespace CatchKit::Detail {
     using Detail::AutoReg;
+    using Detail::TestDescriptor;
+    using Detail::ConstantTestHeader;
+    using Detail::TestHeader;
+    using Detail::test_header;
+    using Detail::get_constant_test_header;
+    using Detail::DescriptorRegistrar;
     using Detail::Test;
+    using Detail::TestFunction;
     using Detail::SectionInfo;
     using Detail::ExecutionNodes;
     using Detail::GeneratorAcquirer;
     using Detail::get_execution_nodes_from_result_handler;
     using Detail::make_test_info;
+    using Detail::run_test_paths;
+    using Detail::run_test_paths_in_parallel;
+    using Detail::PathPartition;
+    using Detail::hash_test_identity;
+    using Detail::shard_for_test;
+    using Detail::TestFilter;
+    using Detail::TestIndex;
+    using Detail::IndexedTest;
+    using Detail::TestSet;
+    using Detail::get_tests;
+    using Detail::wildcard_match;
+    using Detail::StringPool;
+    using Detail::get_string_pool;
+    using Detail::intern;
 }
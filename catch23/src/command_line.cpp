@@ -3,6 +3,8 @@
 //
 
 #include "catch23/command_line.h"
+#include "catch23/process_pool.h"
+#include "catch23/test_filter.h"
 
 #include <print>
 
@@ -13,6 +15,19 @@ namespace CatchKit {
         return
               Flag("-h --help", "help", config.help)
             | Flag("-s --success", "include successful tests in output", config.show_successful_tests)
+            | Opt ("-j --jobs", "number of threads to run tests on (defaults to 1)", config.jobs)
+            | Opt ("--shrink-batch", "how many shrink candidates to try at once, on separate threads (defaults to 1)", config.shrink_batch)
+            | Flag("--split-paths", "run the generated values of each test across threads (-j sets how many)", config.split_paths)
+            | Flag("--fork", "run tests in forked worker processes, isolating crashes (-j sets how many)", config.fork_workers)
+            | Opt ("--shard-count", "split the tests into this many shards (defaults to 1)", config.shard_count)
+            | Opt ("--shard-index", "which shard to run, from 0 to shard-count - 1 (defaults to 0)", config.shard_index)
+            | Opt ("--durations", "file to record test durations in, which are used to schedule later runs", config.durations_file)
+            | Opt ("--balance-shards", "balance shards by the test durations in this file, which is only read (give every shard the same one)", config.shard_durations_file)
+            | Opt ("--timeout", "fail tests that run for longer than this many milliseconds (defaults to 0, for no limit)", config.timeout)
+            | Opt ("--abort-after --max-failures", "stop running tests once this many have failed (defaults to 0, to run all tests)", config.abort_after)
+            | Opt ("--max-elements", "show at most this many elements of each range in assertion output (defaults to 100, 0 for all)", config.max_elements)
+            | Opt ("--max-chars", "truncate each value in assertion output to this many characters (defaults to 16384, 0 for no limit)", config.max_chars)
+            | Opt ("--max-depth", "show ranges nested at most this deep in assertion output (defaults to 8, 0 for no limit)", config.max_depth)
             // | Flag("-b --break", "break into debugger on failure", config.break_into_debugger)
             // | Opt ("-r --reporter", "reporter to use (defaults to console)", config.reporter)
                 // .transform(tolower)
@@ -33,6 +48,53 @@ namespace CatchKit {
             // !TBD: show usage
             return std::unexpected(0);
         }
+        if( config.jobs < 1 ) {
+            std::println("--jobs must be at least 1");
+            return std::unexpected(1);
+        }
+        if( config.shrink_batch < 1 ) {
+            std::println("--shrink-batch must be at least 1");
+            return std::unexpected(1);
+        }
+        if( config.fork_workers && !Detail::process_pool_is_supported() ) {
+            std::println("--fork is not supported on this platform");
+            return std::unexpected(1);
+        }
+        if( config.shard_count < 1 ) {
+            std::println("--shard-count must be at least 1");
+            return std::unexpected(1);
+        }
+        if( config.shard_index < 0 || config.shard_index >= config.shard_count ) {
+            std::println("--shard-index must be at least 0 and less than --shard-count ({})", config.shard_count);
+            return std::unexpected(1);
+        }
+        if( !config.shard_durations_file.empty() ) {
+            if( config.shard_count < 2 ) {
+                std::println("--balance-shards needs --shard-count of at least 2");
+                return std::unexpected(1);
+            }
+            // Each shard writes its own --durations file, so they would soon disagree about which tests go where
+            if( config.shard_durations_file == config.durations_file ) {
+                std::println("--balance-shards must not use the --durations file, as each shard would update its own copy");
+                return std::unexpected(1);
+            }
+        }
+        if( auto filter = Detail::TestFilter::parse( config.tests_or_tags ); !filter ) {
+            std::println("{}", filter.error());
+            return std::unexpected(1);
+        }
+        if( config.timeout < 0 ) {
+            std::println("--timeout must not be negative");
+            return std::unexpected(1);
+        }
+        if( config.abort_after < 0 ) {
+            std::println("--abort-after must not be negative");
+            return std::unexpected(1);
+        }
+        if( config.max_elements < 0 || config.max_chars < 0 || config.max_depth < 0 ) {
+            std::println("--max-elements, --max-chars and --max-depth must not be negative");
+            return std::unexpected(1);
+        }
         // !TBD: any unrecognised args?
 
         return config;
@@ -5,6 +5,8 @@
 #include "catch23/console_reporter.h"
 
 #include <cassert>
+#include <ranges>
+#include <string_view>
 
 #include "catch23/print.h"
 #include "catch23/test_info.h"
@@ -141,6 +143,12 @@ namespace CatchKit {
                             std::println("failed to match");
                     }
                 }
+                if( !match_expr->mismatch.empty() ) {
+                    if( match_expr->sub_expressions.empty() )
+                        std::println();
+                    for( auto const line : std::views::split( match_expr->mismatch, '\n' ) )
+                        println( ColourIntent::SecondaryText, "    {}", std::string_view( line.begin(), line.end() ) );
+                }
             }
             std::println();
         }
@@ -0,0 +1,190 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/duration_history.h"
+#include "catch23/sharding.h"
+
+#include "catchkit/internal_platform.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef CATCHKIT_PLATFORM_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CatchKit::Detail {
+
+    namespace {
+        struct Header {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t entry_size; // also catches files written on a platform with a different layout
+            std::uint64_t entry_count;
+        };
+        constexpr std::array<char, 8> history_magic = { 'C', '2', '3', 'D', 'U', 'R', 'N', 'S' };
+        constexpr std::uint32_t history_version = 1;
+
+        static_assert( std::is_trivially_copyable_v<DurationHistory::Entry> );
+        static_assert( sizeof(Header) % alignof(DurationHistory::Entry) == 0 );
+
+        auto is_valid( Header const& header, std::size_t file_size ) -> bool {
+            return header.magic == history_magic
+                && header.version == history_version
+                && header.entry_size == sizeof(DurationHistory::Entry)
+                && file_size == sizeof(Header) + header.entry_count * sizeof(DurationHistory::Entry);
+        }
+
+        auto by_key = []( DurationHistory::Entry const& lhs, DurationHistory::Entry const& rhs ) {
+            return lhs.key < rhs.key;
+        };
+
+        // Weight the latest run equally with all the history, so we adapt quickly if a test changes
+        auto smooth( std::int64_t previous, std::int64_t latest ) -> std::int64_t {
+            return previous + (latest - previous) / 2;
+        }
+    }
+
+    DurationHistory::~DurationHistory() {
+        unmap();
+    }
+
+    void DurationHistory::unmap() {
+#ifdef CATCHKIT_PLATFORM_POSIX
+        if( mapped_data )
+            ::munmap( mapped_data, mapped_size );
+#endif
+        mapped_data = nullptr;
+        mapped_size = 0;
+        entries = {};
+    }
+
+    auto DurationHistory::load( std::string const& path ) -> bool { // NOSONAR NOLINT (misc-typo)
+        unmap();
+        owned_entries.clear();
+        mean_duration = {};
+
+#ifdef CATCHKIT_PLATFORM_POSIX
+        auto fd = ::open( path.c_str(), O_RDONLY );
+        if( fd < 0 )
+            return false;
+        struct stat file_stat{};
+        if( ::fstat( fd, &file_stat ) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(Header) ) {
+            ::close( fd );
+            return false;
+        }
+        auto file_size = static_cast<std::size_t>(file_stat.st_size);
+        auto data = ::mmap( nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( data == MAP_FAILED )
+            return false;
+
+        Header header{};
+        std::memcpy( &header, data, sizeof(Header) );
+        if( !is_valid( header, file_size ) ) {
+            ::munmap( data, file_size );
+            return false;
+        }
+        mapped_data = data;
+        mapped_size = file_size;
+        entries = { reinterpret_cast<Entry const*>( static_cast<char const*>(data) + sizeof(Header) ), header.entry_count }; // NOLINT
+#else
+        std::ifstream file( path, std::ios::binary );
+        if( !file )
+            return false;
+        auto file_size = static_cast<std::size_t>( std::filesystem::file_size( path ) );
+        Header header{};
+        if( !file.read( reinterpret_cast<char*>(&header), sizeof(Header) ) || !is_valid( header, file_size ) ) // NOLINT
+            return false;
+        owned_entries.resize( header.entry_count );
+        if( !file.read( reinterpret_cast<char*>(owned_entries.data()), header.entry_count * sizeof(Entry) ) ) { // NOLINT
+            owned_entries.clear();
+            return false;
+        }
+        entries = owned_entries;
+#endif
+        if( !std::ranges::is_sorted( entries, by_key ) ) {
+            unmap();
+            owned_entries.clear();
+            return false;
+        }
+        if( !entries.empty() ) {
+            auto total = std::ranges::fold_left( entries, std::int64_t{}, []( std::int64_t acc, Entry const& entry ) {
+                return acc + entry.nanoseconds;
+            });
+            mean_duration = std::chrono::nanoseconds( total / static_cast<std::int64_t>( entries.size() ) );
+        }
+        return true;
+    }
+
+    auto DurationHistory::save( std::string const& path ) const -> bool {
+        auto measurements = new_measurements;
+        std::ranges::stable_sort( measurements, by_key );
+
+        // Merge the sorted, loaded, entries with the sorted new measurements
+        std::vector<Entry> merged;
+        merged.reserve( entries.size() + measurements.size() );
+        auto existing = entries.begin();
+        for( auto const& measurement : measurements ) {
+            for(; existing != entries.end() && existing->key < measurement.key; ++existing )
+                merged.push_back( *existing );
+            if( !merged.empty() && merged.back().key == measurement.key ) {
+                // Measured more than once in this run (e.g. re-run by name)
+                merged.back().nanoseconds = smooth( merged.back().nanoseconds, measurement.nanoseconds );
+                merged.back().runs++;
+            }
+            else if( existing != entries.end() && existing->key == measurement.key ) {
+                auto entry = *existing++;
+                entry.nanoseconds = smooth( entry.nanoseconds, measurement.nanoseconds );
+                entry.runs++;
+                merged.push_back( entry );
+            }
+            else
+                merged.push_back( measurement );
+        }
+        merged.insert( merged.end(), existing, entries.end() );
+
+        Header header{
+            .magic = history_magic,
+            .version = history_version,
+            .entry_size = sizeof(Entry),
+            .entry_count = merged.size() };
+
+        // Write to a temporary and rename over the original, so readers never see a partial file
+        auto temp_path = path + ".tmp";
+        {
+            std::ofstream file( temp_path, std::ios::binary | std::ios::trunc );
+            file.write( reinterpret_cast<char const*>(&header), sizeof(Header) ); // NOLINT
+            file.write( reinterpret_cast<char const*>(merged.data()), static_cast<std::streamsize>( merged.size() * sizeof(Entry) ) ); // NOLINT
+            if( !file )
+                return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename( temp_path, path, ec );
+        return !ec;
+    }
+
+    void DurationHistory::record( TestInfo const& test_info, std::chrono::nanoseconds duration ) {
+        new_measurements.push_back( Entry{ .key = hash_test_identity( test_info ), .nanoseconds = duration.count(), .runs = 1 } );
+    }
+
+    auto DurationHistory::find( TestInfo const& test_info ) const -> std::optional<std::chrono::nanoseconds> {
+        auto key = hash_test_identity( test_info );
+        auto it = std::ranges::lower_bound( entries, key, {}, &Entry::key );
+        if( it == entries.end() || it->key != key )
+            return {};
+        return std::chrono::nanoseconds( it->nanoseconds );
+    }
+
+    auto DurationHistory::estimate( TestInfo const& test_info ) const -> std::chrono::nanoseconds {
+        return find( test_info ).value_or( mean_duration );
+    }
+
+} // namespace CatchKit::Detail
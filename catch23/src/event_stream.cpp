@@ -0,0 +1,328 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/event_stream.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        enum class EventType : std::uint8_t {
+            TestStart,
+            TestEnd,
+            AssertionStart,
+            AssertionEnd,
+            ShrinkStart,
+            ShrinkFound,
+            NoShrinkFound,
+            ShrinkResult,
+            ShrinkEnd,
+            TestComplete
+        };
+
+        // Beyond this we flush, even if we would otherwise hold on to events
+        constexpr std::size_t max_buffered_bytes = 64 * 1024;
+
+        using FrameSize = std::uint32_t;
+
+        template<typename T>
+        void write_raw( std::string& out, T const& value ) {
+            static_assert( std::is_trivially_copyable_v<T> );
+            out.append( reinterpret_cast<char const*>(&value), sizeof(T) ); // NOLINT
+        }
+        void write_string( std::string& out, std::string_view str ) {
+            write_raw( out, static_cast<std::uint32_t>( str.size() ) );
+            out.append( str );
+        }
+        void write_context( std::string& out, AssertionContext const& context ) {
+            write_string( out, context.macro_name );
+            write_string( out, context.original_expression );
+            write_string( out, context.message );
+            write_raw( out, context.location );
+        }
+        void write_expression_info( std::string& out, ExpressionInfo const& expression_info ) {
+            write_raw( out, static_cast<std::uint8_t>( expression_info.index() ) );
+            std::visit( [&out]<typename T>( T const& expr ) {
+                if constexpr( std::same_as<T, UnaryExpressionInfo> ) {
+                    write_string( out, expr.value );
+                }
+                else if constexpr( std::same_as<T, BinaryExpressionInfo> ) {
+                    write_string( out, expr.lhs );
+                    write_string( out, expr.rhs );
+                    write_string( out, expr.op );
+                }
+                else if constexpr( std::same_as<T, MatchExpressionInfo> ) {
+                    write_string( out, expr.candidate_value );
+                    write_string( out, expr.matcher );
+                    write_raw( out, static_cast<std::uint32_t>( expr.sub_expressions.size() ) );
+                    for( auto const& sub_expr : expr.sub_expressions ) {
+                        write_string( out, sub_expr.description );
+                        write_raw( out, sub_expr.result );
+                    }
+                    write_string( out, expr.mismatch );
+                }
+                else if constexpr( std::same_as<T, ExceptionExpressionInfo> ) {
+                    write_string( out, expr.exception_message );
+                    write_raw( out, expr.type );
+                }
+                // monostate and ExpectationExpressionInfo have no data
+            }, expression_info );
+        }
+
+        class FrameReader {
+            std::string_view data;
+        public:
+            explicit FrameReader( std::string_view data ) : data( data ) {}
+
+            template<typename T>
+            auto read() -> T {
+                static_assert( std::is_trivially_copyable_v<T> );
+                assert( data.size() >= sizeof(T) );
+                T value;
+                std::memcpy( &value, data.data(), sizeof(T) );
+                data.remove_prefix( sizeof(T) );
+                return value;
+            }
+            auto read_string() -> std::string_view {
+                auto size = read<std::uint32_t>();
+                assert( data.size() >= size );
+                auto str = data.substr( 0, size );
+                data.remove_prefix( size );
+                return str;
+            }
+        };
+    }
+
+    EventEncoder::EventEncoder( ReportOn what_to_report_on, std::function<void(std::string_view)> flush_to )
+    :   what_to_report_on( what_to_report_on ),
+        flush_to( std::move(flush_to) )
+    {}
+
+    void EventEncoder::begin_frame( std::uint8_t event_type ) {
+        frame_start = buffer.size();
+        write_raw( buffer, FrameSize{} ); // placeholder - filled in by end_frame
+        write_raw( buffer, event_type );
+    }
+    void EventEncoder::end_frame( bool flush_now ) {
+        auto frame_size = static_cast<FrameSize>( buffer.size() - frame_start - sizeof(FrameSize) );
+        std::memcpy( buffer.data() + frame_start, &frame_size, sizeof(FrameSize) );
+        if( flush_now || buffer.size() > max_buffered_bytes )
+            flush();
+    }
+    void EventEncoder::flush() {
+        if( buffer.empty() )
+            return;
+        flush_to( buffer );
+        buffer.clear();
+    }
+
+    void EventEncoder::on_test_complete() {
+        begin_frame( std::to_underlying( EventType::TestComplete ) );
+        end_frame( true );
+    }
+
+    // Test runs are bracketed by the receiving side
+    void EventEncoder::on_test_run_start() { /* not forwarded */ }
+    void EventEncoder::on_test_run_end() { /* not forwarded */ }
+
+    // We flush eagerly at points that would help to diagnose a crash
+    void EventEncoder::on_test_start( TestInfo const& ) {
+        begin_frame( std::to_underlying( EventType::TestStart ) );
+        end_frame( true );
+    }
+    void EventEncoder::on_test_end( TestInfo const&, Counters const& assertions ) {
+        begin_frame( std::to_underlying( EventType::TestEnd ) );
+        write_raw( buffer, assertions );
+        end_frame();
+    }
+
+    void EventEncoder::on_assertion_start( AssertionContext const& context ) {
+        begin_frame( std::to_underlying( EventType::AssertionStart ) );
+        write_context( buffer, context );
+        end_frame();
+    }
+    void EventEncoder::on_assertion_end( AssertionContext const& context, AssertionInfo const& assertion_info ) {
+        begin_frame( std::to_underlying( EventType::AssertionEnd ) );
+        write_context( buffer, context );
+        write_raw( buffer, assertion_info.result );
+        write_expression_info( buffer, assertion_info.expression_info );
+        write_string( buffer, assertion_info.message );
+        write_raw( buffer, static_cast<std::uint32_t>( assertion_info.variables.size() ) );
+        for( auto const& var : assertion_info.variables ) {
+            write_string( buffer, var.name );
+            write_string( buffer, var.type );
+            write_string( buffer, var.value );
+        }
+        end_frame( assertion_info.failed() );
+    }
+
+    void EventEncoder::on_shrink_start() {
+        begin_frame( std::to_underlying( EventType::ShrinkStart ) );
+        end_frame();
+    }
+    void EventEncoder::on_shrink_found( std::vector<std::string> const& values, int shrinks ) {
+        begin_frame( std::to_underlying( EventType::ShrinkFound ) );
+        write_raw( buffer, static_cast<std::uint32_t>( values.size() ) );
+        for( auto const& value : values )
+            write_string( buffer, value );
+        write_raw( buffer, shrinks );
+        end_frame();
+    }
+    void EventEncoder::on_no_shrink_found( int shrinks ) {
+        begin_frame( std::to_underlying( EventType::NoShrinkFound ) );
+        write_raw( buffer, shrinks );
+        end_frame();
+    }
+    void EventEncoder::on_shrink_result( ResultType result, int shrinks_so_far ) {
+        begin_frame( std::to_underlying( EventType::ShrinkResult ) );
+        write_raw( buffer, result );
+        write_raw( buffer, shrinks_so_far );
+        end_frame();
+    }
+    void EventEncoder::on_shrink_end() {
+        begin_frame( std::to_underlying( EventType::ShrinkEnd ) );
+        end_frame();
+    }
+
+    auto EventDecoder::store( std::string_view str ) -> std::string_view {
+        return strings.emplace_back( str );
+    }
+
+    void EventDecoder::reset() {
+        release_strings();
+        last_location.reset();
+        in_test = false;
+        shrinking = false;
+    }
+
+    auto EventDecoder::decode( std::string& inbox, Reporter& target, TestInfo const& test_info ) -> bool { // NOSONAR NOLINT (misc-typo)
+        std::size_t consumed = 0;
+        bool test_complete = false;
+
+        auto read_context = [this]( FrameReader& reader ) {
+            AssertionContext context{
+                .macro_name = store( reader.read_string() ),
+                .original_expression = store( reader.read_string() ),
+                .message = store( reader.read_string() ),
+                .location = reader.read<std::source_location>() };
+            last_location = context.location;
+            return context;
+        };
+        auto read_expression_info = []( FrameReader& reader ) -> ExpressionInfo {
+            switch( reader.read<std::uint8_t>() ) {
+            case 0:
+                return std::monostate{};
+            case 1:
+                return UnaryExpressionInfo{ std::string( reader.read_string() ) };
+            case 2: {
+                auto lhs = std::string( reader.read_string() );
+                auto rhs = std::string( reader.read_string() );
+                return BinaryExpressionInfo{ std::move(lhs), std::move(rhs), reader.read_string() };
+            }
+            case 3: {
+                MatchExpressionInfo match_info;
+                match_info.candidate_value = reader.read_string();
+                match_info.matcher = reader.read_string();
+                auto count = reader.read<std::uint32_t>();
+                match_info.sub_expressions.reserve( count );
+                for( std::uint32_t i = 0; i < count; ++i ) {
+                    auto description = std::string( reader.read_string() );
+                    match_info.sub_expressions.emplace_back( std::move(description), reader.read<bool>() );
+                }
+                match_info.mismatch = reader.read_string();
+                return match_info;
+            }
+            case 4: {
+                auto message = std::string( reader.read_string() );
+                return ExceptionExpressionInfo{ std::move(message), reader.read<ExceptionExpressionInfo::Type>() };
+            }
+            case 5:
+                return ExpectationExpressionInfo{};
+            default:
+                assert( false );
+                return std::monostate{};
+            }
+        };
+
+        while( !test_complete && inbox.size() - consumed >= sizeof(FrameSize) ) {
+            FrameSize frame_size;
+            std::memcpy( &frame_size, inbox.data() + consumed, sizeof(FrameSize) );
+            if( inbox.size() - consumed - sizeof(FrameSize) < frame_size )
+                break; // wait for the rest of the frame
+
+            FrameReader reader( std::string_view( inbox ).substr( consumed + sizeof(FrameSize), frame_size ) );
+            consumed += sizeof(FrameSize) + frame_size;
+
+            switch( static_cast<EventType>( reader.read<std::uint8_t>() ) ) {
+            case EventType::TestStart:
+                in_test = true;
+                target.on_test_start( test_info );
+                break;
+            case EventType::TestEnd:
+                in_test = false;
+                target.on_test_end( test_info, reader.read<Counters>() );
+                break;
+            case EventType::AssertionStart:
+                target.on_assertion_start( read_context( reader ) );
+                break;
+            case EventType::AssertionEnd: {
+                auto context = read_context( reader );
+                AssertionInfo assertion_info;
+                assertion_info.result = reader.read<AdjustedResult>();
+                assertion_info.expression_info = read_expression_info( reader );
+                // BinaryExpressionInfo::op is a view, so needs to live as long as the other strings
+                if( auto binary_info = std::get_if<BinaryExpressionInfo>( &assertion_info.expression_info ) )
+                    binary_info->op = store( binary_info->op );
+                assertion_info.message = reader.read_string();
+                auto count = reader.read<std::uint32_t>();
+                assertion_info.variables.reserve( count );
+                for( std::uint32_t i = 0; i < count; ++i ) {
+                    auto name = std::string( reader.read_string() );
+                    auto type = std::string( reader.read_string() );
+                    assertion_info.variables.emplace_back( std::move(name), std::move(type), std::string( reader.read_string() ) );
+                }
+                target.on_assertion_end( context, assertion_info );
+                break;
+            }
+            case EventType::ShrinkStart:
+                shrinking = true;
+                target.on_shrink_start();
+                break;
+            case EventType::ShrinkFound: {
+                auto count = reader.read<std::uint32_t>();
+                std::vector<std::string> values;
+                values.reserve( count );
+                for( std::uint32_t i = 0; i < count; ++i )
+                    values.emplace_back( reader.read_string() );
+                target.on_shrink_found( values, reader.read<int>() );
+                break;
+            }
+            case EventType::NoShrinkFound:
+                target.on_no_shrink_found( reader.read<int>() );
+                break;
+            case EventType::ShrinkResult: {
+                auto result = reader.read<ResultType>();
+                target.on_shrink_result( result, reader.read<int>() );
+                break;
+            }
+            case EventType::ShrinkEnd:
+                shrinking = false;
+                target.on_shrink_end();
+                break;
+            case EventType::TestComplete:
+                test_complete = true;
+                break;
+            default:
+                assert( false );
+            }
+        }
+        inbox.erase( 0, consumed );
+        return test_complete;
+    }
+
+} // namespace CatchKit::Detail
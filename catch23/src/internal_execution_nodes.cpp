@@ -4,8 +4,30 @@
 
 #include "catch23/internal_execution_nodes.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
 namespace CatchKit::Detail {
 
+    namespace {
+        // Derived from the partition's seed and where the node is (including the file, so generators at the same
+        // line and column of different files don't get the same values), so it's the same in every partition
+        auto nested_seed( unsigned int partition_seed, NodeId const& id ) -> unsigned int {
+            std::vector<std::uint32_t> entropy{ std::uint32_t{ partition_seed }, std::uint32_t{ id.location.line() }, std::uint32_t{ id.location.column() } };
+            for( unsigned char c : std::string_view( id.location.file_name() ) )
+                entropy.push_back( c );
+            std::seed_seq sequence( entropy.begin(), entropy.end() );
+            std::array<std::uint32_t, 1> seed{};
+            sequence.generate( seed.begin(), seed.end() );
+            return seed[0];
+        }
+    }
+
     auto ExecutionNode::get_current_node() const -> ExecutionNode* {
         assert(container);
         return container->current_node;
@@ -27,6 +49,20 @@ namespace CatchKit::Detail {
         return add_child( std::make_unique<ExecutionNode>(id_to_add) );
     }
 
+    auto ExecutionNode::clone_tree( ExecutionNodes* new_container ) const -> std::unique_ptr<ExecutionNode> { // NOLINT NOSONAR
+        auto copy = clone_node();
+        if( !copy )
+            return nullptr;
+        copy->container = new_container;
+        for( auto const& child : children ) {
+            auto child_copy = child->clone_tree( new_container );
+            if( !child_copy )
+                return nullptr;
+            copy->add_child( std::move(child_copy) );
+        }
+        return copy;
+    }
+
     void ExecutionNode::reset() {
         if( state != States::NotEntered ) {
             state = States::NotEntered;
@@ -98,6 +134,10 @@ namespace CatchKit::Detail {
 
     auto ExecutionNodes::add_node(std::unique_ptr<ExecutionNode>&& child) -> ExecutionNode& {
         child->container = this;
+        if( partition && partitioned_size == 0 && current_node == &root && root.children.empty() )
+            partitioned_size = child->apply_partition( *partition );
+        else if( partition && partition->seed )
+            child->reseed( nested_seed( *partition->seed, child->id ) );
         return current_node->add_child(std::move(child));
     }
 
@@ -108,6 +148,40 @@ namespace CatchKit::Detail {
         return new_node;
     }
 
+    auto ExecutionNodes::clone() const -> std::unique_ptr<ExecutionNodes> {
+        auto copy = std::make_unique<ExecutionNodes>( root.id );
+        copy->root.state = root.state;
+        copy->root.current_index = root.current_index;
+        for( auto const& child : root.children ) {
+            auto child_copy = child->clone_tree( copy.get() );
+            if( !child_copy )
+                return nullptr;
+            copy->root.add_child( std::move(child_copy) );
+        }
+        copy->current_node = current_node ? copy->find_corresponding( *current_node ) : nullptr;
+        copy->partition = partition;
+        copy->partitioned_size = partitioned_size;
+        return copy;
+    }
+
+    auto ExecutionNodes::find_corresponding( ExecutionNode const& other_node ) -> ExecutionNode* {
+        // Record the route from the other root, as child indices, then follow it from ours
+        std::vector<std::size_t> route;
+        for( auto node = &other_node; node->parent; node = node->parent ) {
+            auto const& siblings = node->parent->children;
+            auto it = std::ranges::find_if( siblings, [node]( auto const& sibling ) { return sibling.get() == node; } );
+            assert( it != siblings.end() );
+            route.push_back( static_cast<std::size_t>( it - siblings.begin() ) );
+        }
+        ExecutionNode* node = &root;
+        for( auto index : route | std::views::reverse ) {
+            if( index >= node->children.size() )
+                return nullptr;
+            node = node->children[index].get();
+        }
+        return node;
+    }
+
     auto ExecutionNode::freeze() -> States {
         States prev_state = state;
         state = States::Frozen;
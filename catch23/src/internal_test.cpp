@@ -16,4 +16,8 @@ namespace CatchKit::Detail {
     AutoReg::AutoReg(Test&& test) {
         register_test(std::move(test));
     }
+
+    DescriptorRegistrar::DescriptorRegistrar( TestDescriptor const& descriptor ) {
+        register_test_descriptor( descriptor );
+    }
 }
@@ -0,0 +1,399 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/process_pool.h"
+#include "catch23/runner.h"
+
+#include "catchkit/internal_platform.h"
+
+#ifdef CATCHKIT_PLATFORM_POSIX
+
+#include "catch23/event_stream.h"
+#include "catch23/recording_reporter.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        using TestNumber = std::uint32_t; // position in the tests being run (not to be confused with TestIndex)
+
+        auto write_all( int fd, std::string_view data ) -> bool {
+            while( !data.empty() ) {
+                auto written = ::write( fd, data.data(), data.size() );
+                if( written < 0 ) {
+                    if( errno == EINTR )
+                        continue;
+                    return false;
+                }
+                data.remove_prefix( static_cast<std::size_t>(written) );
+            }
+            return true;
+        }
+        auto read_all( int fd, char* data, std::size_t size ) -> bool {
+            while( size > 0 ) {
+                auto bytes_read = ::read( fd, data, size );
+                if( bytes_read < 0 && errno == EINTR )
+                    continue;
+                if( bytes_read <= 0 )
+                    return false;
+                data += bytes_read;
+                size -= static_cast<std::size_t>(bytes_read);
+            }
+            return true;
+        }
+
+        auto elapsed_since( std::chrono::steady_clock::time_point start ) -> std::chrono::nanoseconds {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start );
+        }
+
+        auto describe_exit_status( int status ) -> std::string {
+            if( WIFSIGNALED(status) ) {
+                auto signal = WTERMSIG(status);
+                return std::format( "Test process was terminated by signal {} ({})", signal, ::strsignal(signal) );
+            }
+            if( WIFEXITED(status) )
+                return std::format( "Test process exited unexpectedly with code {}", WEXITSTATUS(status) );
+            return "Test process ended unexpectedly";
+        }
+
+        // Runs in the forked process: takes test indices from commands_fd until it is closed,
+        // and writes the resulting events to events_fd
+        [[noreturn]] void run_worker( std::vector<Test const*> const& tests, ReportOn report_on, ProcessPoolOptions const& options, int commands_fd, int events_fd ) {
+            EventEncoder encoder( report_on, [events_fd]( std::string_view bytes ) {
+                if( !write_all( events_fd, bytes ) )
+                    ::_exit( 1 ); // parent has gone away
+            });
+            TestResultHandler handler( encoder );
+            handler.set_shrink_batch_size( options.shrink_batch_size );
+            handler.set_stringify_limits( options.stringify_limits );
+
+            TestNumber index;
+            while( read_all( commands_fd, reinterpret_cast<char*>(&index), sizeof(index) ) ) { // NOLINT
+                run_test_paths( *tests[index], handler );
+                encoder.on_test_complete();
+            }
+            std::fflush( nullptr );
+            // Don't run any static destructors or atexit handlers - they belong to the parent
+            ::_exit( 0 );
+        }
+
+        struct Worker {
+            pid_t pid = -1;
+            int commands_fd = -1; // we write test indices to this
+            int events_fd = -1; // and read encoded events from this
+            std::string inbox;
+            EventDecoder decoder;
+            RecordingReporter recorder;
+            std::optional<TestNumber> current_test;
+            std::chrono::steady_clock::time_point test_started;
+            std::optional<std::chrono::steady_clock::time_point> deadline;
+            std::optional<std::chrono::milliseconds> killed_after; // set if we killed it for running too long
+
+            explicit Worker( ReportOn report_on ) : recorder( report_on ) {}
+
+            void close_pipes() {
+                if( commands_fd != -1 )
+                    ::close( commands_fd );
+                if( events_fd != -1 )
+                    ::close( events_fd );
+                commands_fd = events_fd = -1;
+            }
+        };
+
+        class ProcessPool {
+            std::vector<Test const*> const& tests;
+            Reporter& reporter;
+            ProcessPoolOptions const& options;
+            std::vector<std::unique_ptr<Worker>> workers;
+            TestNumber next_test = 0;
+            bool stopping = false;
+
+            void spawn( Worker& worker ) {
+                int commands[2];
+                int events[2];
+                if( ::pipe( commands ) != 0 )
+                    throw std::system_error( errno, std::generic_category(), "Unable to create pipe for test worker" );
+                if( ::pipe( events ) != 0 ) {
+                    auto error = errno;
+                    ::close( commands[0] );
+                    ::close( commands[1] );
+                    throw std::system_error( error, std::generic_category(), "Unable to create pipe for test worker" );
+                }
+
+                // Anything still buffered would otherwise be written by both processes
+                std::fflush( nullptr );
+
+                auto pid = ::fork();
+                if( pid < 0 )
+                    throw std::system_error( errno, std::generic_category(), "Unable to fork test worker" );
+                if( pid == 0 ) {
+                    // We must not hold on to other workers' pipes, or they won't see the ends close
+                    for( auto const& other : workers )
+                        other->close_pipes();
+                    ::close( commands[1] );
+                    ::close( events[0] );
+                    run_worker( tests, reporter.report_on_what(), options, commands[0], events[1] );
+                }
+                ::close( commands[0] );
+                ::close( events[1] );
+
+                worker.pid = pid;
+                worker.commands_fd = commands[1];
+                worker.events_fd = events[0];
+                worker.inbox.clear();
+                worker.decoder.reset();
+                worker.current_test.reset();
+                worker.killed_after.reset();
+            }
+
+            void dispatch( Worker& worker ) {
+                if( next_test == tests.size() || stopping )
+                    return;
+                worker.current_test = next_test++;
+                worker.test_started = std::chrono::steady_clock::now();
+                worker.deadline.reset();
+                if( auto time_limit = tests[*worker.current_test]->test_info.time_limit( options.default_time_limit ) )
+                    worker.deadline = worker.test_started + *time_limit;
+                auto index = *worker.current_test;
+                // If this fails the worker has died, which we'll find out about when we next read from it
+                write_all( worker.commands_fd, std::string_view( reinterpret_cast<char const*>(&index), sizeof(index) ) ); // NOLINT
+            }
+
+            void report_timing( Worker const& worker ) const {
+                if( options.on_test_timed )
+                    options.on_test_timed( *tests[*worker.current_test], elapsed_since( worker.test_started ) );
+            }
+
+            // Kills any tests still running, and stops handing out new ones
+            void stop_early() {
+                stopping = true;
+                for( auto& worker : workers ) {
+                    if( worker->current_test )
+                        ::kill( worker->pid, SIGKILL );
+                }
+            }
+            void check_for_stop() {
+                if( !stopping && options.should_stop && options.should_stop() )
+                    stop_early();
+            }
+
+            void test_complete( Worker& worker ) {
+                if( stopping ) {
+                    // We've already killed it, so it won't be given any more tests
+                    worker.recorder.discard();
+                    worker.decoder.release_strings();
+                    worker.current_test.reset();
+                    return;
+                }
+                report_timing( worker );
+                worker.recorder.replay_into( reporter );
+                worker.decoder.release_strings();
+                worker.current_test.reset();
+                check_for_stop();
+                if( worker.killed_after )
+                    worker_died( worker ); // the test finished just as we killed it, so just replace the worker
+                else
+                    dispatch( worker );
+            }
+
+            // Report what we can of the test that was running, then fail it
+            void worker_died( Worker& worker ) {
+                int status = 0;
+                while( ::waitpid( worker.pid, &status, 0 ) < 0 && errno == EINTR ) {}
+                worker.close_pipes();
+
+                if( worker.current_test && stopping ) {
+                    worker.recorder.discard();
+                    worker.decoder.release_strings();
+                }
+                else if( worker.current_test ) {
+                    report_timing( worker );
+                    auto const& test_info = tests[*worker.current_test]->test_info;
+                    auto& recorder = worker.recorder;
+                    if( worker.decoder.is_shrinking() )
+                        recorder.on_shrink_end();
+                    if( !worker.decoder.is_in_test() )
+                        recorder.on_test_start( test_info );
+
+                    auto message = worker.killed_after
+                        ? std::format( "Test timed out after {}, so its process was killed", *worker.killed_after )
+                        : describe_exit_status( status );
+                    AssertionContext context{
+                        .macro_name = "",
+                        .original_expression = "",
+                        .message = message,
+                        .location = worker.decoder.get_last_location().value_or( test_info.location ) };
+                    recorder.on_assertion_start( context );
+                    recorder.on_assertion_end( context, AssertionInfo{ AdjustedResult::Failed, std::monostate{}, message, {} } );
+                    recorder.on_test_end( test_info, Counters{ .failed = 1 } );
+                    recorder.replay_into( reporter );
+                    worker.decoder.release_strings();
+                    check_for_stop();
+                }
+                if( next_test < tests.size() && !stopping ) {
+                    spawn( worker );
+                    dispatch( worker );
+                }
+                else
+                    worker.current_test.reset();
+            }
+
+            void read_events( Worker& worker ) {
+                char buffer[64 * 1024];
+                auto bytes_read = ::read( worker.events_fd, buffer, sizeof(buffer) );
+                if( bytes_read < 0 && errno == EINTR )
+                    return;
+                if( bytes_read > 0 ) {
+                    worker.inbox.append( buffer, static_cast<std::size_t>(bytes_read) );
+                    if( worker.current_test
+                            && worker.decoder.decode( worker.inbox, worker.recorder, tests[*worker.current_test]->test_info ) )
+                        test_complete( worker );
+                }
+                else
+                    worker_died( worker );
+            }
+
+        public:
+            // Kills any workers whose test has run past its deadline, then returns how long (in ms)
+            // we can wait before the next deadline, or -1 if there is none
+            auto enforce_deadlines() -> int {
+                using namespace std::chrono;
+                auto now = steady_clock::now();
+                std::optional<steady_clock::time_point> next_deadline;
+                for( auto& worker : workers ) {
+                    if( !worker->current_test || !worker->deadline || worker->killed_after )
+                        continue;
+                    if( *worker->deadline <= now ) {
+                        // We'll see the pipe close, then report it, in worker_died()
+                        worker->killed_after = duration_cast<milliseconds>( *worker->deadline - worker->test_started );
+                        ::kill( worker->pid, SIGKILL );
+                    }
+                    else if( !next_deadline || *worker->deadline < *next_deadline )
+                        next_deadline = worker->deadline;
+                }
+                if( !next_deadline )
+                    return -1;
+                return static_cast<int>( ceil<milliseconds>( *next_deadline - now ).count() );
+            }
+
+            ProcessPool( std::vector<Test const*> const& tests, Reporter& reporter, ProcessPoolOptions const& options )
+            :   tests( tests ),
+                reporter( reporter ),
+                options( options )
+            {}
+
+            void run() {
+                auto count = std::min( static_cast<std::size_t>(options.worker_count), tests.size() );
+                for( std::size_t i = 0; i < count; ++i ) {
+                    auto& worker = *workers.emplace_back( std::make_unique<Worker>( reporter.report_on_what() ) );
+                    spawn( worker );
+                    dispatch( worker );
+                }
+
+                std::vector<pollfd> poll_fds;
+                std::vector<Worker*> polled_workers;
+                while( true ) {
+                    poll_fds.clear();
+                    polled_workers.clear();
+                    for( auto& worker : workers ) {
+                        if( worker->current_test ) {
+                            poll_fds.push_back( pollfd{ .fd = worker->events_fd, .events = POLLIN, .revents = 0 } );
+                            polled_workers.push_back( worker.get() );
+                        }
+                    }
+                    if( poll_fds.empty() )
+                        break;
+
+                    if( ::poll( poll_fds.data(), poll_fds.size(), enforce_deadlines() ) < 0 ) {
+                        if( errno == EINTR )
+                            continue;
+                        throw std::system_error( errno, std::generic_category(), "Failed waiting for test workers" );
+                    }
+                    for( std::size_t i = 0; i < poll_fds.size(); ++i ) {
+                        if( poll_fds[i].revents != 0 )
+                            read_events( *polled_workers[i] );
+                    }
+                }
+            }
+
+            ~ProcessPool() {
+                // Closing the command pipe tells the worker to exit
+                for( auto& worker : workers ) {
+                    if( worker->pid != -1 && worker->commands_fd != -1 ) {
+                        worker->close_pipes();
+                        while( ::waitpid( worker->pid, nullptr, 0 ) < 0 && errno == EINTR ) {}
+                    }
+                }
+            }
+        };
+
+        // Writing to the pipe of a worker that has died would otherwise kill us
+        class IgnoreSigPipe {
+            struct sigaction previous_action{};
+        public:
+            IgnoreSigPipe() {
+                struct sigaction action{};
+                action.sa_handler = SIG_IGN;
+                ::sigaction( SIGPIPE, &action, &previous_action );
+            }
+            ~IgnoreSigPipe() {
+                ::sigaction( SIGPIPE, &previous_action, nullptr );
+            }
+        };
+    }
+
+    auto process_pool_is_supported() -> bool { return true; }
+
+    void run_tests_in_process_pool(
+            std::vector<Test const*> const& tests,
+            Reporter& reporter,
+            ProcessPoolOptions const& options ) {
+        IgnoreSigPipe ignore_sig_pipe;
+        ProcessPool pool( tests, reporter, options );
+        pool.run();
+    }
+
+} // namespace CatchKit::Detail
+
+#else // CATCHKIT_PLATFORM_POSIX
+
+namespace CatchKit::Detail {
+
+    auto process_pool_is_supported() -> bool { return false; }
+
+    // Not supported on this platform, so we just run the tests in this process (without time limits)
+    void run_tests_in_process_pool(
+            std::vector<Test const*> const& tests,
+            Reporter& reporter,
+            ProcessPoolOptions const& options ) {
+        TestResultHandler handler( reporter );
+        handler.set_shrink_batch_size( options.shrink_batch_size );
+        handler.set_stringify_limits( options.stringify_limits );
+        for( auto const test : tests ) {
+            if( options.should_stop && options.should_stop() )
+                break;
+            auto start = std::chrono::steady_clock::now();
+            run_test_paths( *test, handler );
+            if( options.on_test_timed )
+                options.on_test_timed( *test, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ) );
+        }
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_PLATFORM_POSIX
@@ -0,0 +1,77 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/recording_reporter.h"
+
+#include <string>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        // The message may be a view onto a buffer that is reused by the time we replay,
+        // so we hold onto our own copy of it
+        struct RecordedContext {
+            AssertionContext context;
+            std::string message;
+
+            explicit RecordedContext( AssertionContext const& context )
+            :   context( context ),
+                message( context.message )
+            {}
+            auto get() const -> AssertionContext {
+                auto copy = context;
+                copy.message = message;
+                return copy;
+            }
+        };
+    }
+
+    void RecordingReporter::replay_into( Reporter& target ) {
+        for( auto const& event : events )
+            event( target );
+        events.clear();
+    }
+
+    void RecordingReporter::on_test_run_start() {
+        events.emplace_back( []( Reporter& target ) { target.on_test_run_start(); } );
+    }
+    void RecordingReporter::on_test_run_end() {
+        events.emplace_back( []( Reporter& target ) { target.on_test_run_end(); } );
+    }
+
+    void RecordingReporter::on_test_start( TestInfo const& test_info ) {
+        events.emplace_back( [&test_info]( Reporter& target ) { target.on_test_start( test_info ); } );
+    }
+    void RecordingReporter::on_test_end( TestInfo const& test_info, Counters const& assertions ) {
+        events.emplace_back( [&test_info, assertions]( Reporter& target ) { target.on_test_end( test_info, assertions ); } );
+    }
+
+    void RecordingReporter::on_assertion_start( AssertionContext const& context ) {
+        events.emplace_back( [recorded = RecordedContext( context )]( Reporter& target ) {
+            target.on_assertion_start( recorded.get() );
+        });
+    }
+    void RecordingReporter::on_assertion_end( AssertionContext const& context, AssertionInfo const& assertion_info ) {
+        events.emplace_back( [recorded = RecordedContext( context ), assertion_info]( Reporter& target ) {
+            target.on_assertion_end( recorded.get(), assertion_info );
+        });
+    }
+
+    void RecordingReporter::on_shrink_start() {
+        events.emplace_back( []( Reporter& target ) { target.on_shrink_start(); } );
+    }
+    void RecordingReporter::on_shrink_found( std::vector<std::string> const& values, int shrinks ) {
+        events.emplace_back( [values, shrinks]( Reporter& target ) { target.on_shrink_found( values, shrinks ); } );
+    }
+    void RecordingReporter::on_no_shrink_found( int shrinks ) {
+        events.emplace_back( [shrinks]( Reporter& target ) { target.on_no_shrink_found( shrinks ); } );
+    }
+    void RecordingReporter::on_shrink_result( ResultType result, int shrinks_so_far ) {
+        events.emplace_back( [result, shrinks_so_far]( Reporter& target ) { target.on_shrink_result( result, shrinks_so_far ); } );
+    }
+    void RecordingReporter::on_shrink_end() {
+        events.emplace_back( []( Reporter& target ) { target.on_shrink_end(); } );
+    }
+
+} // namespace CatchKit::Detail
@@ -4,10 +4,22 @@
 
 #include "catch23/runner.h"
 #include "catch23/internal_execution_nodes.h"
+#include "catch23/recording_reporter.h"
+#include "catch23/sharding.h"
+#include "catch23/process_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace CatchKit::Detail {
 
     namespace {
+        auto elapsed_since( std::chrono::steady_clock::time_point start ) -> std::chrono::nanoseconds {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start );
+        }
         void handle_unexpected_exception( TestResultHandler& test_handler ) {
             // We need a new context because the old one had string_views to outdated data
             // - we want to preserve the last known source location, though
@@ -27,7 +39,7 @@ namespace CatchKit::Detail {
         }
         void invoke_test( Test const& test, TestResultHandler& test_handler ) {
             Checker old_checker = std::move(::catch23_checker);
-            ::catch23_checker = Checker{ .result_handler=&test_handler };
+            ::catch23_checker = Checker{ .result_handler=&test_handler, .fast_pass=test_handler.get_fast_pass_flag() };
 
             try {
                 test.test_fun(::catch23_checker);
@@ -36,18 +48,151 @@ namespace CatchKit::Detail {
                 // allow test cancellation to pass through
             }
             catch( ... ) { // NOSONAR NOLINT (misc-typo)
-                handle_unexpected_exception( test_handler );
+                ::catch23_checker.flush_fast_passes();
+                try {
+                    handle_unexpected_exception( test_handler );
+                }
+                catch( TestCancelled ) { // NOSONAR NOLINT (misc-typo)
+                    // the test was cancelled (e.g. timed out) before the exception could be reported
+                }
             }
+            ::catch23_checker.flush_fast_passes();
             ::catch23_checker = std::move(old_checker);
         }
     }
+    namespace {
+        // Collects the results of assertions made while trying a shrink candidate, so they can be
+        // passed on later - but only if the serial algorithm would have tried that candidate, too
+        class ShrinkResultCollector : public Reporter {
+            ReportOn what_to_report_on;
+        public:
+            std::vector<ResultType> results;
+
+            explicit ShrinkResultCollector( ReportOn what_to_report_on ) : what_to_report_on( what_to_report_on ) {}
+
+            [[nodiscard]] auto report_on_what() const -> ReportOn override { return what_to_report_on; }
+            void on_test_run_start() override { /* no impl */ }
+            void on_test_run_end() override { /* no impl */ }
+            void on_test_start( TestInfo const& ) override { /* no impl */ }
+            void on_test_end( TestInfo const&, Counters const& ) override { /* no impl */ }
+            void on_assertion_start( AssertionContext const& ) override { /* no impl */ }
+            void on_assertion_end( AssertionContext const&, AssertionInfo const& ) override { /* no impl */ }
+            void on_shrink_start() override { /* no impl */ }
+            void on_shrink_found( std::vector<std::string> const&, int ) override { /* no impl */ }
+            void on_no_shrink_found( int ) override { /* no impl */ }
+            void on_shrink_result( ResultType result, int ) override { results.push_back( result ); }
+            void on_shrink_end() override { /* no impl */ }
+        };
+
+        struct ShrinkCandidate {
+            std::unique_ptr<ExecutionNodes> execution_nodes; // holding the candidate value(s)
+            ShrinkResultCollector collector;
+            bool failed = false;
+
+            void evaluate( Test const& test, TestResultHandler const& test_handler ) {
+                TestResultHandler handler( collector );
+                handler.follow_cancellation_of( test_handler );
+                handler.use_settings_of( test_handler );
+                ScopedStringifyLimits limits( handler.get_stringify_limits() );
+                handler.on_test_start( test.test_info );
+                handler.on_shrink_start();
+                handler.set_execution_nodes( execution_nodes.get() );
+                execution_nodes->get_root().enter();
+
+                invoke_test( test, handler );
+
+                failed = !handler.passed();
+                handler.set_execution_nodes( nullptr );
+            }
+        };
+
+        // Tries the candidate currently held in the shrinkable node
+        void try_shrink_candidate( Test const& test, TestResultHandler& test_handler, ShrinkableNode& shrinkable, ExecutionNode& root_node, ExecutionNode& leaf_node ) {
+            root_node.enter();
+
+            invoke_test(test, test_handler);
+
+            if(!test_handler.passed())
+                shrinkable.rebase_shrink(); // Resets on current failing number
+
+            leaf_node.freeze();
+            root_node.exit();
+        }
+
+        // Tries candidates batch_size at a time, each on its own thread, with its own copy of the execution nodes.
+        // The first failure in a batch is the one the serial algorithm would have found, so that is the one we
+        // rebase on - and any candidates after it are forgotten, as if they had never been generated
+        void shrink_speculatively(
+                Test const& test,
+                TestResultHandler& test_handler,
+                ExecutionNode& shrinking_node,
+                ShrinkableNode& shrinkable,
+                ExecutionNode& root_node,
+                ExecutionNode& leaf_node ) {
+            auto& execution_nodes = *test_handler.get_execution_nodes();
+            auto const batch_size = test_handler.get_shrink_batch_size();
+            auto const report_on = test_handler.get_reporter().report_on_what();
+
+            auto candidate_in = []( ShrinkCandidate const& candidate, ExecutionNode const& node ) -> ShrinkableNode const& {
+                auto corresponding_node = candidate.execution_nodes->find_corresponding( node );
+                assert( corresponding_node && corresponding_node->get_shrinkable() );
+                return *corresponding_node->get_shrinkable(); // NOLINT
+            };
+
+            std::vector<std::unique_ptr<ShrinkCandidate>> batch;
+            batch.reserve( batch_size );
+            bool exhausted = false;
+            while( !exhausted && !test_handler.is_cancelled() ) {
+                batch.clear();
+                bool uncopyable = false; // the latest candidate couldn't be copied, so must be tried in place
+                while( batch.size() < batch_size ) {
+                    if( !shrinkable.shrink() ) {
+                        exhausted = true;
+                        break;
+                    }
+                    auto candidate_nodes = execution_nodes.clone();
+                    if( !candidate_nodes ) {
+                        uncopyable = true;
+                        break;
+                    }
+                    batch.emplace_back( std::make_unique<ShrinkCandidate>( std::move(candidate_nodes), ShrinkResultCollector( report_on ) ) );
+                }
+                {
+                    std::vector<std::jthread> threads;
+                    threads.reserve( batch.size() );
+                    for( auto& candidate : batch )
+                        threads.emplace_back( [&test, &test_handler, &candidate = *candidate] { candidate.evaluate( test, test_handler ); } );
+                }
+
+                auto first_failure = std::ranges::find_if( batch, []( auto const& candidate ) { return candidate->failed; } );
+                auto tried_serially = first_failure == batch.end() ? batch.end() : std::next( first_failure );
+                for( auto const& candidate : std::ranges::subrange( batch.begin(), tried_serially ) ) {
+                    for( auto result : candidate->collector.results )
+                        test_handler.record_shrink_result( result );
+                }
+
+                if( first_failure != batch.end() ) {
+                    for( auto const& candidate : std::ranges::subrange( tried_serially, batch.end() ) )
+                        shrinkable.forget_shrink_candidate( candidate_in( *candidate, shrinking_node ) );
+                    if( uncopyable )
+                        shrinkable.forget_shrink_candidate( shrinkable );
+                    shrinkable.adopt_shrink_candidate( candidate_in( **first_failure, shrinking_node ) );
+                    shrinkable.rebase_shrink();
+                    exhausted = false; // we have a new starting point
+                }
+                else if( uncopyable )
+                    try_shrink_candidate( test, test_handler, shrinkable, root_node, leaf_node );
+            }
+        }
+    }
+
     auto try_shrink( Test const& test, TestResultHandler& test_handler, ExecutionNode* leaf_node ) {
 
-        std::vector<ShrinkableNode*> shrinkables; // NOLINT (misc-typo)
+        std::vector<std::pair<ExecutionNode*, ShrinkableNode*>> shrinkables; // NOLINT (misc-typo)
         auto node = leaf_node;
         for(; node->get_parent(); node = node->get_parent())
             if( auto shrinkable = node->get_shrinkable())
-                shrinkables.push_back( shrinkable );
+                shrinkables.emplace_back( node, shrinkable );
 
         if( shrinkables.empty() )
             return;
@@ -60,18 +205,13 @@ namespace CatchKit::Detail {
         root_node.exit();
         std::vector<std::string> shrunk_values;
         shrunk_values.reserve( shrinkables.size() );
-        for( auto& shrinkable : shrinkables ) {
+        for( auto [shrinking_node, shrinkable] : shrinkables ) {
             shrinkable->start_shrinking();
-            while( shrinkable->shrink() ) {
-                root_node.enter();
-
-                invoke_test(test, test_handler);
-
-                if(!test_handler.passed())
-                    shrinkable->rebase_shrink(); // Resets on current failing number
-
-                leaf_node->freeze();
-                root_node.exit();
+            if( test_handler.get_shrink_batch_size() > 1 )
+                shrink_speculatively( test, test_handler, *shrinking_node, *shrinkable, root_node, *leaf_node );
+            else {
+                while( !test_handler.is_cancelled() && shrinkable->shrink() )
+                    try_shrink_candidate( test, test_handler, *shrinkable, root_node, *leaf_node );
             }
             if( shrinkable->stop_shrinking() )
                 shrunk_values.push_back( shrinkable->current_value_as_string() );
@@ -79,60 +219,282 @@ namespace CatchKit::Detail {
         test_handler.on_shrink_found(shrunk_values);
 
         root_node.enter();
-        invoke_test(test, test_handler);
+        if( !test_handler.is_cancelled() )
+            invoke_test(test, test_handler);
         // don't do final exit as it will happen in caller
         test_handler.on_shrink_end();
 
     }
-    auto TestRunner::matches_config( Test const& test ) const -> bool {
-        // !TBD: Just matches exact test name, for now
-        if( test.test_info.name == config.tests_or_tags )
-            return true;
-        return false;
+
+    namespace {
+        // Runs the next path through the test
+        void run_path( Test const& test, TestResultHandler& test_handler, ExecutionNodes& execution_nodes ) {
+            auto& root_node = execution_nodes.get_root();
+            ScopedStringifyLimits limits( test_handler.get_stringify_limits() );
+            test_handler.on_test_start(test.test_info);
+
+            root_node.enter();
+            assert(root_node.get_state() != ExecutionNode::States::Completed);
+
+            invoke_test(test, test_handler);
+
+            auto current_execution_node = execution_nodes.get_current_node();
+            if( !test_handler.passed() && !test_handler.is_cancelled() )
+                try_shrink(test, test_handler, current_execution_node);
+
+            root_node.exit();
+
+            test_handler.on_test_end(test.test_info);
+        }
+        auto all_paths_run( ExecutionNodes& execution_nodes ) -> bool {
+            return execution_nodes.get_root().get_state() == ExecutionNode::States::Completed;
+        }
+
+        // Runs the paths selected by the partition in its own thread, recording the results
+        struct PathWorker {
+            RecordingReporter recorder;
+            TestResultHandler handler;
+            std::jthread thread;
+
+            PathWorker( Test const& test, TestResultHandler const& test_handler, PathPartition const& partition )
+            :   recorder( test_handler.get_reporter().report_on_what() ),
+                handler( recorder ),
+                thread( [&test, this, &test_handler, partition] {
+                    handler.follow_cancellation_of( test_handler );
+                    handler.use_settings_of( test_handler );
+                    run_test_paths( test, handler, partition );
+                } )
+            {}
+        };
     }
-    auto TestRunner::should_test_run( Test const& test ) const -> bool {
-        return config.tests_or_tags.empty()
-            ? !test.test_info.has_tag_type(Tag::Type::mute)
-            : this->matches_config(test);
+
+    void run_test_paths( Test const& test, TestResultHandler& test_handler, std::optional<PathPartition> const& partition ) {
+        ExecutionNodes execution_nodes({std::string(test.test_info.name), test.test_info.location});
+        if( partition )
+            execution_nodes.partition_paths( *partition );
+        test_handler.set_execution_nodes(&execution_nodes);
+
+        // If the test is cancelled we don't try any further paths (it has already been reported as failing)
+        do {
+            run_path(test, test_handler, execution_nodes);
+        }
+        while( !all_paths_run(execution_nodes) && !test_handler.is_cancelled() );
+
+        test_handler.set_execution_nodes(nullptr);
+    }
+
+    void run_test_paths_in_parallel( Test const& test, TestResultHandler& test_handler, std::size_t worker_count ) {
+        ExecutionNodes execution_nodes({std::string(test.test_info.name), test.test_info.location});
+        execution_nodes.partition_paths( PathPartition{ .offset = 0, .stride = worker_count } );
+        test_handler.set_execution_nodes(&execution_nodes);
+
+        // We don't know if there is anything to split up until we've been through the test once
+        run_path(test, test_handler, execution_nodes);
+        if( test_handler.is_cancelled() ) {
+            test_handler.set_execution_nodes(nullptr);
+            return;
+        }
+
+        std::vector<std::unique_ptr<PathWorker>> path_workers;
+        if( execution_nodes.get_partitioned_size() > 1 ) {
+            auto partitions = std::min( worker_count, execution_nodes.get_partitioned_size() );
+            for( std::size_t offset = 1; offset < partitions; ++offset ) {
+                auto worker_partition = *execution_nodes.get_partition(); // now includes the seed
+                worker_partition.offset = offset;
+                path_workers.emplace_back( std::make_unique<PathWorker>( test, test_handler, worker_partition ) );
+            }
+        }
+        while( !all_paths_run(execution_nodes) && !test_handler.is_cancelled() )
+            run_path(test, test_handler, execution_nodes);
+
+        test_handler.set_execution_nodes(nullptr);
+
+        for( auto& path_worker : path_workers ) {
+            path_worker->thread.join();
+            path_worker->recorder.replay_into( test_handler.get_reporter() );
+        }
+    }
+
+    auto TestRunner::select_tests( TestIndex const& index ) const -> TestSet {
+        if( !index.get_soloed().empty() )
+            return index.get_soloed();
+        return filter ? filter->select( index ) : TestFilter().select( index );
     }
     void TestRunner::run_tests( TestRegistry const& tests ) {
-        run_tests( tests.get_all_tests() );
+        auto const& index = tests.get_index();
+        run_tests( tests.get_tests( select_tests( index ) ), !index.get_soloed().empty() );
+    }
+
+    auto TestRunner::select_shard( std::vector<Test const*> const& tests ) const -> std::vector<Test const*> {
+        if( config.shard_durations_file.empty() ) {
+            return tests
+                | std::views::filter( [this]( Test const* test ) {
+                        return shard_for_test( test->test_info, config.shard_count ) == config.shard_index;
+                    })
+                | std::ranges::to<std::vector>();
+        }
+
+        // Balance the shards by giving each test, longest first, to the shard with the least work so far.
+        // Every shard computes the same assignment, as long as they are all given the same (read-only) history file
+        auto longest_first = tests;
+        order_longest_first( longest_first, shard_history );
+
+        std::vector<std::chrono::nanoseconds> shard_loads( static_cast<std::size_t>(config.shard_count) );
+        std::vector<Test const*> selected;
+        for( auto const test : longest_first ) {
+            auto least_loaded = std::ranges::min_element( shard_loads );
+            *least_loaded += shard_history.estimate( test->test_info );
+            if( least_loaded - shard_loads.begin() == config.shard_index )
+                selected.push_back( test );
+        }
+        return selected;
+    }
+
+    void TestRunner::order_longest_first( std::vector<Test const*>& tests, DurationHistory const& history ) {
+        struct Scheduled {
+            std::chrono::nanoseconds estimate;
+            std::uint64_t hash;
+            Test const* test;
+        };
+        auto scheduled = tests
+            | std::views::transform( [&history]( Test const* test ) {
+                    return Scheduled{ history.estimate( test->test_info ), hash_test_identity( test->test_info ), test };
+                })
+            | std::ranges::to<std::vector>();
+
+        // Ties (including tests with no history) are broken by hash, so the order is the same everywhere
+        std::ranges::sort( scheduled, []( Scheduled const& lhs, Scheduled const& rhs ) {
+            if( lhs.estimate != rhs.estimate )
+                return lhs.estimate > rhs.estimate;
+            return lhs.hash < rhs.hash;
+        });
+        std::ranges::copy( scheduled | std::views::transform( &Scheduled::test ), tests.begin() );
+    }
+
+    void TestRunner::record_duration( Test const& test, std::chrono::nanoseconds duration ) {
+        if( !config.durations_file.empty() )
+            duration_history.record( test.test_info, duration );
     }
 
-    void TestRunner::run_tests( std::vector<Test const*> const& tests_to_run, bool soloing ) {
+    auto TestRunner::watch_for_timeout( Test const& test, TestResultHandler& handler ) -> Watchdog::Watch {
+        auto time_limit = test.test_info.time_limit( std::chrono::milliseconds( config.timeout ) );
+        handler.reset_cancellation( time_limit.value_or( std::chrono::milliseconds::zero() ) );
+        if( !time_limit )
+            return {};
+        return watchdog.watch( *time_limit, [&handler] { handler.request_cancellation( CancellationReason::TimedOut ); } );
+    }
+
+    auto TestRunner::check_for_abort() -> bool {
+        if( config.abort_after > 0 && tally.get_test_totals().failed >= config.abort_after )
+            aborting = true;
+        return aborting;
+    }
+
+    void TestRunner::run_tests( std::vector<Test const*> const& all_tests_to_run, bool soloing ) {
         result_handler.get_reporter().on_test_run_start();
         if( soloing )
             println( ColourIntent::Warning, "\nWarning: Running soloed test(s) (tests with the [solo] tag) only.\n");
-        for( auto const test : tests_to_run) {
-            run_test( *test );
+
+        auto const sharding = config.shard_count > 1;
+        auto tests_to_run = sharding ? select_shard( all_tests_to_run ) : all_tests_to_run;
+        if( sharding )
+            println( ColourIntent::Headers, "Shard {} of {}: running {} of {} test(s)",
+                config.shard_index, config.shard_count, tests_to_run.size(), all_tests_to_run.size() );
+
+        auto const parallel = config.fork_workers || (config.jobs > 1 && !config.split_paths);
+
+        // Starting the longest tests first means we're less likely to be left waiting for one at the end
+        if( parallel && !duration_history.empty() )
+            order_longest_first( tests_to_run, duration_history );
+
+        if( config.fork_workers ) {
+            run_tests_in_process_pool( tests_to_run, result_handler.get_reporter(), {
+                .worker_count = config.jobs,
+                .default_time_limit = std::chrono::milliseconds( config.timeout ),
+                .shrink_batch_size = static_cast<std::size_t>( config.shrink_batch ),
+                .stringify_limits = result_handler.get_stringify_limits(),
+                .on_test_timed = [this]( Test const& test, std::chrono::nanoseconds duration ) { record_duration( test, duration ); },
+                .should_stop = [this] { return check_for_abort(); } } );
+        }
+        else if( parallel && tests_to_run.size() > 1 )
+            run_tests_in_parallel( tests_to_run );
+        else {
+            for( auto const test : tests_to_run) {
+                if( check_for_abort() )
+                    break;
+                auto start = std::chrono::steady_clock::now();
+                {
+                    auto watch = watch_for_timeout( *test, result_handler );
+                    if( config.split_paths && config.jobs > 1 )
+                        run_test_paths_in_parallel( *test, result_handler, static_cast<std::size_t>(config.jobs) );
+                    else
+                        run_test( *test );
+                }
+                record_duration( *test, elapsed_since( start ) );
+            }
         }
+        if( aborting )
+            println( ColourIntent::Warning, "\nAborted after {} failed test(s)", tally.get_test_totals().failed );
         result_handler.get_reporter().on_test_run_end();
-    }
-
-    void TestRunner::run_test( Test const& test ) {
-        ExecutionNodes execution_nodes({test.test_info.name, test.test_info.location});
-        auto& root_node = execution_nodes.get_root();
-        result_handler.set_execution_nodes(&execution_nodes);
 
-        do {
-            result_handler.on_test_start(test.test_info);
+        if( !config.durations_file.empty() && !duration_history.save( config.durations_file ) )
+            println( ColourIntent::Warning, "Warning: Unable to write test durations to {}", config.durations_file );
+    }
 
-            root_node.enter();
-            assert(root_node.get_state() != ExecutionNode::States::Completed);
+    void TestRunner::run_tests_in_parallel( std::vector<Test const*> const& tests_to_run ) {
+        auto& reporter = result_handler.get_reporter();
+        std::mutex reporter_mutex;
+        std::atomic<std::size_t> next_test = 0;
 
-            invoke_test(test, result_handler);
+        // Each worker has its own handler (and, in invoke_test, its own thread_local checker).
+        // Events are recorded per test, then replayed as a block so output is not interleaved
+        struct Worker {
+            RecordingReporter recorder;
+            TestResultHandler handler;
+            Worker( ReportOn report_on, TestResultHandler const& settings_from ) : recorder( report_on ), handler( recorder ) {
+                handler.use_settings_of( settings_from );
+            }
+        };
+        auto worker_count = std::min( static_cast<std::size_t>(config.jobs), tests_to_run.size() );
+        std::vector<std::unique_ptr<Worker>> workers;
+        workers.reserve( worker_count );
+        for( std::size_t i = 0; i < worker_count; ++i )
+            workers.emplace_back( std::make_unique<Worker>( reporter.report_on_what(), result_handler ) );
 
-            auto current_execution_node = execution_nodes.get_current_node();
-            if( !result_handler.passed() )
-                try_shrink(test, result_handler, current_execution_node);
+        auto run_worker = [&]( Worker& worker ) {
+            for( auto index = next_test++; index < tests_to_run.size() && !aborting; index = next_test++ ) {
+                auto start = std::chrono::steady_clock::now();
+                {
+                    auto watch = watch_for_timeout( *tests_to_run[index], worker.handler );
+                    run_test_paths( *tests_to_run[index], worker.handler );
+                }
+                auto duration = elapsed_since( start );
 
-            root_node.exit();
+                std::scoped_lock lock( reporter_mutex );
+                if( worker.handler.was_cut_short() && worker.handler.get_cancellation_reason() == CancellationReason::Aborted ) {
+                    // Cut short, so reporting it would only skew the totals.
+                    // (A test that had finished before the abort is still reported, and timed, as normal)
+                    worker.recorder.discard();
+                    continue;
+                }
+                worker.recorder.replay_into( reporter );
+                record_duration( *tests_to_run[index], duration );
+                if( check_for_abort() ) {
+                    for( auto const& other : workers )
+                        other->handler.request_cancellation( CancellationReason::Aborted );
+                }
+            }
+        };
 
-            result_handler.on_test_end(test.test_info);
-        }
-        while(root_node.get_state() != ExecutionNode::States::Completed);
+        std::vector<std::jthread> threads;
+        threads.reserve( worker_count );
+        for( auto const& worker : workers )
+            threads.emplace_back( run_worker, std::ref( *worker ) );
+        // threads join on destruction
+    }
 
-        result_handler.set_execution_nodes(nullptr);
+    void TestRunner::run_test( Test const& test ) {
+        run_test_paths( test, result_handler );
     }
 
 } // namespace CatchKit::Detail
\ No newline at end of file
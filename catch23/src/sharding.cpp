@@ -0,0 +1,42 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/sharding.h"
+
+#include <string_view>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        // FNV-1a - simple, and specified precisely enough that it won't change underneath us
+        constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+        constexpr std::uint64_t fnv_prime = 1099511628211ULL;
+
+        auto fnv1a( std::string_view text, std::uint64_t hash = fnv_offset_basis ) -> std::uint64_t {
+            for( auto c : text ) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= fnv_prime;
+            }
+            return hash;
+        }
+
+        // The full path depends on where the build happens, so we just use the file name
+        auto file_name_only( std::string_view path ) -> std::string_view {
+            if( auto pos = path.find_last_of("/\\"); pos != std::string_view::npos )
+                return path.substr(pos+1);
+            return path;
+        }
+    }
+
+    auto hash_test_identity( TestInfo const& test_info ) -> std::uint64_t {
+        auto hash = fnv1a( test_info.name );
+        hash = fnv1a( std::string_view("\0", 1), hash );
+        return fnv1a( file_name_only( test_info.location.file_name() ), hash );
+    }
+
+    auto shard_for_test( TestInfo const& test_info, int shard_count ) -> int {
+        return static_cast<int>( hash_test_identity( test_info ) % static_cast<std::uint64_t>(shard_count) );
+    }
+
+} // namespace CatchKit::Detail
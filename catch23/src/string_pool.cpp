@@ -0,0 +1,91 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/string_pool.h"
+
+#include <cstring>
+#include <functional>
+#include <utility>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        auto hash_of( std::string_view str ) -> std::size_t {
+            return std::hash<std::string_view>{}( str );
+        }
+    }
+
+    StringPool::StringPool() : slots( 256 ) {}
+
+    auto StringPool::find_slot( std::size_t hash, std::string_view str ) const -> std::size_t {
+        auto mask = slots.size() - 1;
+        for( auto i = hash & mask;; i = (i + 1) & mask ) {
+            auto const& slot = slots[i];
+            if( !slot.str.data() || (slot.hash == hash && slot.str == str) )
+                return i;
+        }
+    }
+
+    auto StringPool::copy_in( std::string_view str ) -> std::string_view {
+        if( str.size() > chars_left ) {
+            // Strings too big for a block get one of their own, so we don't waste the rest of the current one
+            if( str.size() > block_size / 4 ) {
+                auto& block = blocks.emplace_back( std::make_unique_for_overwrite<char[]>( str.size() ) );
+                std::memcpy( block.get(), str.data(), str.size() );
+                return { block.get(), str.size() };
+            }
+            next_char = blocks.emplace_back( std::make_unique_for_overwrite<char[]>( block_size ) ).get();
+            chars_left = block_size;
+        }
+        std::memcpy( next_char, str.data(), str.size() );
+        std::string_view copy( next_char, str.size() );
+        next_char += str.size();
+        chars_left -= str.size();
+        return copy;
+    }
+
+    void StringPool::grow() {
+        auto old_slots = std::exchange( slots, std::vector<Slot>( slots.size() * 2 ) );
+        for( auto const& slot : old_slots ) {
+            if( slot.str.data() )
+                slots[find_slot( slot.hash, slot.str )] = slot;
+        }
+    }
+
+    auto StringPool::intern( std::string_view str ) -> std::string_view {
+        auto hash = hash_of( str );
+        std::scoped_lock lock( mutex );
+        if( auto const& slot = slots[find_slot( hash, str )]; slot.str.data() )
+            return slot.str;
+
+        // Keep the load factor under a half, so probe sequences stay short
+        if( (count + 1) * 2 > slots.size() )
+            grow();
+
+        // Empty strings still need a (non-null) address, to mark the slot as used
+        auto copy = str.empty() ? std::string_view( "" ) : copy_in( str );
+        slots[find_slot( hash, str )] = { hash, copy };
+        ++count;
+        return copy;
+    }
+
+    auto StringPool::find( std::string_view str ) const -> std::optional<std::string_view> {
+        auto hash = hash_of( str );
+        std::scoped_lock lock( mutex );
+        if( auto const& slot = slots[find_slot( hash, str )]; slot.str.data() )
+            return slot.str;
+        return {};
+    }
+
+    auto StringPool::size() const -> std::size_t {
+        std::scoped_lock lock( mutex );
+        return count;
+    }
+
+    auto get_string_pool() -> StringPool& {
+        static StringPool pool; // NOSONAR NOLINT (misc-typo)
+        return pool;
+    }
+
+} // namespace CatchKit::Detail
@@ -0,0 +1,19 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/tallying_reporter.h"
+
+namespace CatchKit::Detail {
+
+    void TallyingReporter::on_test_end( TestInfo const& test_info, Counters const& assertions ) {
+        if( assertions.failed != 0 )
+            test_totals.failed++;
+        else if( assertions.failed_expectedly != 0 )
+            test_totals.failed_expectedly++;
+        else
+            test_totals.passed_explicitly++;
+        target.on_test_end( test_info, assertions );
+    }
+
+} // namespace CatchKit::Detail
@@ -0,0 +1,248 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/test_filter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+namespace CatchKit::Detail {
+
+    auto wildcard_match( std::string_view pattern, std::string_view text ) -> bool {
+        // Greedy, but backtracks to just after the last * (which is all that's ever needed)
+        std::size_t p = 0;
+        std::size_t t = 0;
+        std::size_t last_star = std::string_view::npos;
+        std::size_t star_match = 0;
+        while( t < text.size() ) {
+            if( p < pattern.size() && pattern[p] == '*' ) {
+                last_star = p++;
+                star_match = t;
+            }
+            else if( p < pattern.size() && pattern[p] == text[t] ) {
+                ++p;
+                ++t;
+            }
+            else if( last_star != std::string_view::npos ) {
+                p = last_star + 1;
+                t = ++star_match;
+            }
+            else
+                return false;
+        }
+        while( p < pattern.size() && pattern[p] == '*' )
+            ++p;
+        return p == pattern.size();
+    }
+
+    namespace {
+        using Pattern = TestFilter::Pattern;
+
+        auto is_space( char c ) -> bool {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+        auto trim( std::string_view str ) -> std::string_view {
+            while( !str.empty() && is_space( str.front() ) )
+                str.remove_prefix( 1 );
+            while( !str.empty() && is_space( str.back() ) )
+                str.remove_suffix( 1 );
+            return str;
+        }
+
+        // An unquoted name like path/file.cpp:42 selects by location
+        auto location_or_name( std::string_view text ) -> Pattern {
+            if( auto colon = text.rfind( ':' ); colon != std::string_view::npos && colon > 0 ) {
+                auto file = text.substr( 0, colon );
+                auto line_text = text.substr( colon + 1 );
+                std::uint32_t line = 0;
+                auto [end, error] = std::from_chars( line_text.data(), line_text.data() + line_text.size(), line );
+                if( error == std::errc() && end == line_text.data() + line_text.size()
+                        && file.find_first_of( "./\\" ) != std::string_view::npos
+                        && !file.contains( '*' ) )
+                    return Pattern{ .kind = Pattern::Kind::Location, .text = std::string( file ), .line = line };
+            }
+            return Pattern{ .kind = Pattern::Kind::Name, .text = std::string( text ) };
+        }
+
+        auto file_matches( std::string_view path, std::string_view file ) -> bool {
+            if( !path.ends_with( file ) )
+                return false;
+            if( path.size() == file.size() )
+                return true;
+            auto separator = path[path.size() - file.size() - 1];
+            return separator == '/' || separator == '\\';
+        }
+
+        class FilterParser {
+            std::string_view spec;
+            std::size_t pos = 0;
+            std::vector<TestFilter::Conjunction> alternatives;
+            TestFilter::Conjunction current;
+            std::string name; // unquoted, so far
+            bool negate_next = false;
+
+            void add( Pattern&& pattern ) {
+                pattern.negated = std::exchange( negate_next, false );
+                current.push_back( std::move( pattern ) );
+            }
+            void end_name() {
+                if( auto trimmed = trim( name ); !trimmed.empty() )
+                    add( location_or_name( trimmed ) );
+                name.clear();
+            }
+            auto end_alternative() -> std::expected<void, std::string> {
+                end_name();
+                if( negate_next )
+                    return std::unexpected( std::format( "~ must be followed by a name or tag in test spec: {}", spec ) );
+                if( !current.empty() )
+                    alternatives.push_back( std::exchange( current, {} ) );
+                return {};
+            }
+            // Reads up to the terminator, from just after the current position, leaving pos on the terminator
+            auto read_until( char terminator, std::string_view what ) -> std::expected<std::string, std::string> {
+                std::string text;
+                for( ++pos; pos < spec.size(); ++pos ) {
+                    if( spec[pos] == '\\' && pos + 1 < spec.size() )
+                        text += spec[++pos];
+                    else if( spec[pos] == terminator )
+                        return text;
+                    else
+                        text += spec[pos];
+                }
+                return std::unexpected( std::format( "Unterminated {} in test spec: {}", what, spec ) );
+            }
+
+        public:
+            explicit FilterParser( std::string_view spec ) : spec( spec ) {}
+
+            auto parse() -> std::expected<std::vector<TestFilter::Conjunction>, std::string> {
+                for( ; pos < spec.size(); ++pos ) {
+                    switch( auto c = spec[pos] ) {
+                    case '\\':
+                        if( ++pos < spec.size() )
+                            name += spec[pos];
+                        break;
+                    case '"': {
+                        end_name();
+                        auto quoted = read_until( '"', "quoted name" );
+                        if( !quoted )
+                            return std::unexpected( quoted.error() );
+                        add( Pattern{ .kind = Pattern::Kind::Name, .text = std::move( *quoted ) } );
+                        break;
+                    }
+                    case '[': {
+                        end_name();
+                        auto tag = read_until( ']', "tag" );
+                        if( !tag )
+                            return std::unexpected( tag.error() );
+                        if( tag->empty() )
+                            return std::unexpected( std::format( "Empty tag in test spec: {}", spec ) );
+                        add( Pattern{ .kind = Pattern::Kind::Tag, .text = std::move( *tag ) } );
+                        break;
+                    }
+                    case '~':
+                        // Only a negation at the start of a pattern - otherwise it's part of a name
+                        if( name.empty() || is_space( name.back() ) ) {
+                            end_name();
+                            negate_next = !negate_next;
+                        }
+                        else
+                            name += c;
+                        break;
+                    case ',':
+                        if( auto ended = end_alternative(); !ended )
+                            return std::unexpected( ended.error() );
+                        break;
+                    default:
+                        name += c;
+                    }
+                }
+                if( auto ended = end_alternative(); !ended )
+                    return std::unexpected( ended.error() );
+                return std::move( alternatives );
+            }
+        };
+    }
+
+    auto TestFilter::parse( std::string_view spec ) -> std::expected<TestFilter, std::string> {
+        auto alternatives = FilterParser( spec ).parse();
+        if( !alternatives )
+            return std::unexpected( alternatives.error() );
+        TestFilter filter;
+        filter.alternatives = std::move( *alternatives );
+        return filter;
+    }
+
+    auto TestFilter::select( Pattern const& pattern, TestIndex const& index ) -> TestSet {
+        switch( pattern.kind ) {
+        case Pattern::Kind::Name: {
+            if( !pattern.text.contains( '*' ) )
+                return index.with_name( pattern.text );
+            TestSet matching( index.size() );
+            for( std::size_t i = 0; i < index.size(); ++i ) {
+                if( wildcard_match( pattern.text, index.get_test( i ).name ) )
+                    matching.insert( i );
+            }
+            return matching;
+        }
+        case Pattern::Kind::Tag: {
+            if( !pattern.text.contains( '*' ) )
+                return index.with_tag( pattern.text );
+            // There are far fewer tags than tests, so we match against those, then combine their sets
+            TestSet matching( index.size() );
+            for( auto const& [id, tag_name] : std::views::enumerate( index.get_tag_names() ) ) {
+                if( wildcard_match( pattern.text, tag_name ) )
+                    matching |= index.with_tag( static_cast<TestIndex::TagId>( id ) );
+            }
+            return matching;
+        }
+        case Pattern::Kind::Location: {
+            TestSet matching( index.size() );
+            for( auto const& [file, indices] : index.get_files() ) {
+                if( !file_matches( file, pattern.text ) )
+                    continue;
+                auto line_of = [&index]( std::size_t i ) { return index.get_test( i ).location.line(); };
+                auto after = std::ranges::upper_bound( indices, pattern.line, {}, line_of );
+                if( after == indices.begin() )
+                    continue;
+                // Everything declared on that line (there may be more than one, e.g. from a macro)
+                auto line = line_of( *std::prev( after ) );
+                for( auto it = after; it != indices.begin() && line_of( *std::prev( it ) ) == line; --it )
+                    matching.insert( *std::prev( it ) );
+            }
+            return matching;
+        }
+        default:
+            std::unreachable();
+        }
+    }
+
+    auto TestFilter::select( TestIndex const& index ) const -> TestSet {
+        auto not_muted = [&index] {
+            auto tests = index.all();
+            tests -= index.get_muted();
+            return tests;
+        };
+        if( alternatives.empty() )
+            return not_muted();
+
+        TestSet selected( index.size() );
+        for( auto const& conjunction : alternatives ) {
+            auto matching = std::ranges::all_of( conjunction, &Pattern::negated ) ? not_muted() : index.all();
+            for( auto const& pattern : conjunction ) {
+                if( pattern.negated )
+                    matching -= select( pattern, index );
+                else
+                    matching &= select( pattern, index );
+            }
+            selected |= matching;
+        }
+        return selected;
+    }
+
+} // namespace CatchKit::Detail
@@ -0,0 +1,169 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/test_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <ranges>
+
+namespace CatchKit::Detail {
+
+    TestSet::TestSet( std::size_t size, bool all )
+    :   words( (size + 63) / 64, all ? ~std::uint64_t{0} : 0 ),
+        size( size )
+    {
+        clear_unused_bits();
+    }
+
+    void TestSet::clear_unused_bits() {
+        if( auto used = size % 64; used != 0 )
+            words.back() &= (std::uint64_t{1} << used) - 1;
+    }
+
+    auto TestSet::count() const -> std::size_t {
+        std::size_t total = 0;
+        for( auto word : words )
+            total += static_cast<std::size_t>( std::popcount( word ) );
+        return total;
+    }
+    auto TestSet::empty() const -> bool {
+        return std::ranges::all_of( words, []( auto word ) { return word == 0; } );
+    }
+
+    auto TestSet::operator &= ( TestSet const& other ) -> TestSet& {
+        assert( size == other.size );
+        for( std::size_t i = 0; i < words.size(); ++i )
+            words[i] &= other.words[i];
+        return *this;
+    }
+    auto TestSet::operator |= ( TestSet const& other ) -> TestSet& {
+        assert( size == other.size );
+        for( std::size_t i = 0; i < words.size(); ++i )
+            words[i] |= other.words[i];
+        return *this;
+    }
+    auto TestSet::operator -= ( TestSet const& other ) -> TestSet& {
+        assert( size == other.size );
+        for( std::size_t i = 0; i < words.size(); ++i )
+            words[i] &= ~other.words[i];
+        return *this;
+    }
+
+    auto IndexedTest::has_tag_type( Tag::Type tag_type ) const -> bool {
+        return std::ranges::any_of( tags, [tag_type]( auto const& tag ) { return tag.type == tag_type && !tag.ignored; } );
+    }
+
+    TestIndex::TestIndex( std::span<Test const* const> tests_to_index )
+    :   TestIndex( tests_to_index
+            | std::views::transform( []( Test const* test ) {
+                    auto const& info = test->test_info;
+                    return IndexedTest{ info.name, info.tags, info.location };
+                })
+            | std::ranges::to<std::vector>() )
+    {}
+
+    TestIndex::TestIndex( std::vector<IndexedTest> tests_to_index )
+    :   tests( std::move( tests_to_index ) ),
+        name_slots( std::bit_ceil( tests.size() * 2 + 1 ) ),
+        next_with_same_name( tests.size() ),
+        muted( tests.size() ),
+        soloed( tests.size() )
+    {
+        for( auto&& [index, info] : std::views::enumerate( tests ) ) {
+            auto i = static_cast<std::size_t>( index );
+            for( auto const& tag : info.tags ) {
+                if( !tag.ignored )
+                    tests_by_tag[intern_tag( tag.name )].insert( i );
+            }
+            if( info.has_tag_type( Tag::Type::mute ) )
+                muted.insert( i );
+            if( info.has_tag_type( Tag::Type::solo ) )
+                soloed.insert( i );
+            index_name( i );
+            tests_by_file[info.location.file_name()].push_back( i );
+        }
+        for( auto& [file, indices] : tests_by_file ) {
+            std::ranges::stable_sort( indices, {}, [this]( std::size_t i ) { return tests[i].location.line(); } );
+        }
+    }
+
+    auto TestIndex::intern_tag( std::string_view name ) -> TagId {
+        if( auto it = tag_ids.find( name ); it != tag_ids.end() )
+            return it->second;
+        auto id = static_cast<TagId>( tag_names.size() );
+        tag_names.push_back( name );
+        tests_by_tag.emplace_back( tests.size() );
+        tag_ids.emplace( name, id );
+        return id;
+    }
+
+    namespace {
+        auto name_hash( std::string_view name ) -> std::uint32_t {
+            return static_cast<std::uint32_t>( std::hash<std::string_view>{}( name ) );
+        }
+    }
+
+    // Tests are indexed in order, so each one goes on the end of the chain for its name
+    void TestIndex::index_name( std::size_t index ) {
+        auto name = tests[index].name;
+        auto hash = name_hash( name );
+        auto mask = name_slots.size() - 1;
+        for( auto i = hash & mask;; i = (i + 1) & mask ) {
+            auto& slot = name_slots[i];
+            if( slot.first_test == 0 ) {
+                slot = { hash, static_cast<std::uint32_t>( index + 1 ), static_cast<std::uint32_t>( index + 1 ) };
+                return;
+            }
+            if( slot.hash == hash && tests[slot.first_test - 1].name == name ) {
+                next_with_same_name[slot.last_test - 1] = static_cast<std::uint32_t>( index + 1 );
+                slot.last_test = static_cast<std::uint32_t>( index + 1 );
+                return;
+            }
+        }
+    }
+
+    auto TestIndex::first_with_name( std::string_view name ) const -> std::uint32_t {
+        auto hash = name_hash( name );
+        auto mask = name_slots.size() - 1;
+        for( auto i = hash & mask;; i = (i + 1) & mask ) {
+            auto const& slot = name_slots[i];
+            if( slot.first_test == 0 )
+                return 0;
+            if( slot.hash == hash && tests[slot.first_test - 1].name == name )
+                return slot.first_test;
+        }
+    }
+
+    auto TestIndex::find_tag( std::string_view name ) const -> std::optional<TagId> {
+        if( auto it = tag_ids.find( name ); it != tag_ids.end() )
+            return it->second;
+        return {};
+    }
+    auto TestIndex::with_tag( std::string_view name ) const -> TestSet {
+        if( auto id = find_tag( name ) )
+            return tests_by_tag[*id];
+        return TestSet( tests.size() );
+    }
+    auto TestIndex::with_name( std::string_view name ) const -> TestSet {
+        TestSet matching( tests.size() );
+        for( auto next = first_with_name( name ); next != 0; next = next_with_same_name[next - 1] )
+            matching.insert( next - 1 );
+        return matching;
+    }
+    auto TestIndex::find_by_name( std::string_view name ) const -> std::optional<std::size_t> {
+        if( auto first = first_with_name( name ); first != 0 )
+            return first - 1;
+        return {};
+    }
+
+    auto get_tests( std::span<Test const* const> tests, TestSet const& selected ) -> std::vector<Test const*> {
+        std::vector<Test const*> selected_tests;
+        selected_tests.reserve( selected.count() );
+        selected.for_each( [&]( std::size_t index ) { selected_tests.push_back( tests[index] ); } );
+        return selected_tests;
+    }
+
+} // namespace CatchKit::Detail
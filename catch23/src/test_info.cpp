@@ -17,4 +17,12 @@ namespace CatchKit {
     auto TestInfo::may_fail() const -> bool {
         return has_tag_type(Tag::Type::may_fail);
     }
+    auto TestInfo::time_limit( std::chrono::milliseconds default_limit ) const -> std::optional<std::chrono::milliseconds> {
+        auto it = std::ranges::find_if(tags, [](auto const& tag) { return tag.type == Tag::Type::timeout && !tag.ignored; });
+        if( it != tags.end() )
+            return it->time_limit;
+        if( default_limit > std::chrono::milliseconds::zero() )
+            return default_limit;
+        return {};
+    }
 }
\ No newline at end of file
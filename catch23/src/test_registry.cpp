@@ -4,9 +4,21 @@
 
 #include "catch23/test_registry.h"
 
+#include <algorithm>
 #include <optional>
 #include <cassert>
 #include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#if defined(__ELF__) && defined(__GNUC__)
+// Defined by the linker, if any descriptors were placed in the section (see macros.h)
+extern "C" {
+    extern CatchKit::Detail::TestDescriptor const __start_catch23_tests[] __attribute__((weak)); // NOLINT
+    extern CatchKit::Detail::TestDescriptor const __stop_catch23_tests[] __attribute__((weak)); // NOLINT
+}
+#endif
 
 namespace CatchKit::Detail {
 
@@ -15,48 +27,110 @@ namespace CatchKit::Detail {
             static std::vector<Test> all_tests; // NOSONAR NOLINT (misc-typo)
             return all_tests;
         }
+        auto& get_registered_descriptors() {
+            static std::vector<TestDescriptor const*> descriptors; // NOSONAR NOLINT (misc-typo)
+            return descriptors;
+        }
         bool& is_initialised() {
             static bool initialised = false;
             return initialised;
         }
+
+        auto get_section_descriptors() -> std::span<TestDescriptor const> {
+#if defined(__ELF__) && defined(__GNUC__)
+            if( __start_catch23_tests && __stop_catch23_tests )
+                return { __start_catch23_tests, __stop_catch23_tests };
+#endif
+            return {};
+        }
+
+        // Linkers don't promise to keep descriptors in any particular order, so we sort them by location
+        // (which keeps tests from each file together, in the order they were written)
+        auto get_all_descriptors() -> std::vector<TestDescriptor const*> {
+            auto descriptors = get_registered_descriptors();
+            for( auto const& descriptor : get_section_descriptors() )
+                descriptors.push_back( &descriptor );
+            std::ranges::sort( descriptors, []( TestDescriptor const* lhs, TestDescriptor const* rhs ) {
+                if( auto by_file = std::string_view( lhs->location.file_name() ) <=> std::string_view( rhs->location.file_name() ); by_file != 0 )
+                    return by_file < 0;
+                if( lhs->location.line() != rhs->location.line() )
+                    return lhs->location.line() < rhs->location.line();
+                return lhs->location.column() < rhs->location.column();
+            });
+            return descriptors;
+        }
     }
     void register_test( Test&& test ) {
         assert(!is_initialised()); // We can only call this during startup
         get_registered_tests_impl().emplace_back(std::move(test));
     }
+    void register_test_descriptor( TestDescriptor const& descriptor ) {
+        assert(!is_initialised()); // We can only call this during startup
+        get_registered_descriptors().push_back(&descriptor);
+    }
 
     auto get_test_registry() -> TestRegistry const& {
         static std::optional<TestRegistry> all_tests;
         if( !is_initialised() ) {
-            all_tests = TestRegistry{ std::move(get_registered_tests_impl()) };
+            all_tests.emplace( get_all_descriptors(), std::move( get_registered_tests_impl() ) );
+            get_registered_tests_impl().clear();
             is_initialised() = true;
         }
         return *all_tests;
     }
 
     TestRegistry::TestRegistry( std::vector<Test>&& tests )
-    :   all_tests( std::move( tests ) )
-    {
-        if( tests_by_name.empty() ) {
-            for(auto&& [i, test] : std::views::enumerate( all_tests ) ) {
-                tests_by_name.try_emplace( test.test_info.name, i );
-            }
+    :   TestRegistry( {}, std::move( tests ) )
+    {}
+
+    TestRegistry::TestRegistry( std::span<TestDescriptor const* const> descriptors, std::vector<Test>&& tests ) {
+        entries.reserve( descriptors.size() + tests.size() );
+        for( auto descriptor : descriptors ) {
+            if( descriptor->header )
+                entries.push_back( { .descriptor = descriptor, .test = std::nullopt } );
+            else
+                entries.push_back( { .test = descriptor->make_test() } );
         }
+        for( auto& test : tests )
+            entries.push_back( { .test = std::move( test ) } );
+
+        index = TestIndex( entries
+            | std::views::transform( []( Entry const& entry ) {
+                    if( entry.descriptor ) {
+                        auto const& header = *entry.descriptor->header;
+                        return IndexedTest{ header.name, header.tags, entry.descriptor->location };
+                    }
+                    auto const& info = entry.test->test_info;
+                    return IndexedTest{ info.name, info.tags, info.location };
+                })
+            | std::ranges::to<std::vector>() );
+    }
 
+    auto TestRegistry::get_test( std::size_t index_of_test ) const -> Test const& {
+        std::scoped_lock lock( making_tests );
+        auto& entry = entries[index_of_test];
+        if( entry.descriptor )
+            entry.test.emplace( std::exchange( entry.descriptor, nullptr )->make_test() );
+        return *entry.test;
     }
 
-    auto TestRegistry::find_test_by_name(std::string const& name) const -> Test const* {
-        if( auto it = tests_by_name.find( name ); it != tests_by_name.end() )
-            return &all_tests[it->second];
+    auto TestRegistry::get_tests( TestSet const& selected ) const -> std::vector<Test const*> {
+        std::vector<Test const*> selected_tests;
+        selected_tests.reserve( selected.count() );
+        selected.for_each( [&]( std::size_t index_of_test ) { selected_tests.push_back( &get_test( index_of_test ) ); } );
+        return selected_tests;
+    }
+
+    auto TestRegistry::find_test_by_name( std::string_view name ) const -> Test const* {
+        if( auto found = index.find_by_name( name ) )
+            return &get_test( *found );
         return nullptr;
     }
+
     auto TestRegistry::find_tests_by_tag(std::string tag_name) const -> std::generator<Test const*> {
-        for(auto const& test : all_tests) {
-            for( auto const& tag : test.test_info.tags ) {
-                if( tag.name == tag_name ) {
-                    co_yield &test;
-                }
-            }
+        if( auto tag_id = index.find_tag( tag_name ) ) {
+            for( auto test : get_tests( index.with_tag( *tag_id ) ) )
+                co_yield test;
         }
     }
 
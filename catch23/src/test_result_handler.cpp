@@ -8,6 +8,7 @@
 #include "catchkit/variable_capture_ref.h"
 
 #include <cassert>
+#include <format>
 #include <utility>
 #include <ranges>
 
@@ -20,6 +21,7 @@ namespace CatchKit::Detail {
 
     void TestResultHandler::on_test_start( TestInfo const& test_info ) {
         current_test_info = &test_info;
+        last_assertion_location = test_info.location;
         reporter.on_test_start(test_info);
     }
     void TestResultHandler::on_test_end( TestInfo const& test_info ) {
@@ -29,7 +31,10 @@ namespace CatchKit::Detail {
     }
 
     void TestResultHandler::on_assertion_start( ResultDisposition result_disposition, AssertionContext const& context ) {
+        if( is_cancelled() ) [[unlikely]]
+            cancel_test();
         current_context = context;
+        last_assertion_location = context.location;
         this->current_result_disposition = result_disposition;
         reporter.on_assertion_start( context );
     }
@@ -53,6 +58,10 @@ namespace CatchKit::Detail {
         shrinking_mode = ShrinkingMode::Normal;
         reporter.on_shrink_end();
     }
+    void TestResultHandler::record_shrink_result( ResultType result ) {
+        shrink_count++;
+        reporter.on_shrink_result(result, shrink_count);
+    }
     auto TestResultHandler::on_assertion_result( ResultType result ) -> ResultDetailNeeded {
         if( current_test_info->should_fail() )
             last_result = (result == ResultType::Passed) ? AdjustedResult::Failed : AdjustedResult::Passed;
@@ -62,8 +71,7 @@ namespace CatchKit::Detail {
             last_result = (result == ResultType::Passed) ? AdjustedResult::Passed : AdjustedResult::Failed;
 
         if( shrinking_mode == ShrinkingMode::Shrinking ) {
-            shrink_count++;
-            reporter.on_shrink_result(result, shrink_count);
+            record_shrink_result(result);
             return ResultDetailNeeded::No;
         }
         if( shrinking_mode == ShrinkingMode::NotShrunk )
@@ -102,7 +110,7 @@ namespace CatchKit::Detail {
         return ResultDetailNeeded::Yes;
     }
 
-    void TestResultHandler::on_assertion_result_detail( ExpressionInfo const& expression_info, std::string_view message ) {
+    void TestResultHandler::on_assertion_result_detail( ExpressionInfo&& expression_info, std::string_view message ) {
         assert(current_test_info);
         assert(current_context);
 
@@ -114,7 +122,7 @@ namespace CatchKit::Detail {
             | std::ranges::to<std::vector>();
 
         reporter.on_assertion_end(*current_context,
-            AssertionInfo{ last_result, expression_info, std::string(message), std::move(variables) } );
+            AssertionInfo{ last_result, std::move(expression_info), std::string(message), std::move(variables) } );
     }
 
     void TestResultHandler::on_assertion_end() {
@@ -124,6 +132,22 @@ namespace CatchKit::Detail {
         }
     }
 
+    void TestResultHandler::on_fast_passes( std::size_t count ) {
+        last_result = AdjustedResult::Passed;
+        assertions.passed_explicitly += static_cast<int>( count );
+    }
+
+    auto TestResultHandler::get_fast_pass_flag() const -> std::atomic<bool> const* {
+        // Any of these mean passes are counted differently, or reported
+        if( shrinking_mode != ShrinkingMode::Normal
+                || report_on_passing( report_on )
+                || !current_test_info
+                || current_test_info->should_fail()
+                || current_test_info->has_tag_type( Tag::Type::always_report ) )
+            return nullptr;
+        return followed_not_cancelled;
+    }
+
     void TestResultHandler::add_variable_capture( VariableCaptureRef* capture ) {
         variable_captures.push_back(capture);
     }
@@ -138,6 +162,59 @@ namespace CatchKit::Detail {
         return current_test_info->location;
     }
 
+    void TestResultHandler::request_cancellation( CancellationReason reason ) {
+        if( reason == CancellationReason::Aborted ) {
+            cancellation.store( reason, std::memory_order_release ); // aborting trumps everything
+        }
+        else {
+            auto expected = CancellationReason::None;
+            cancellation.compare_exchange_strong( expected, reason, std::memory_order_acq_rel );
+        }
+        not_cancelled.store( false, std::memory_order_release );
+    }
+    void TestResultHandler::reset_cancellation( std::chrono::milliseconds new_time_limit ) {
+        time_limit = new_time_limit;
+        cut_short = false;
+        auto expected = CancellationReason::TimedOut;
+        if( cancellation.compare_exchange_strong( expected, CancellationReason::None, std::memory_order_acq_rel ) )
+            not_cancelled.store( true, std::memory_order_release );
+    }
+
+    void TestResultHandler::cancel_test() {
+        if( get_cancellation_reason() == CancellationReason::TimedOut )
+            report_timeout();
+        throw TestCancelled(); // NOLINT
+    }
+
+    void TestResultHandler::report_timeout() {
+        // Describe where we were in terms of sections and generators, from the outermost in
+        std::vector<std::string> path;
+        if( execution_nodes ) {
+            for( auto node = execution_nodes->get_current_node(); node; node = node->get_parent() ) {
+                if( auto shrinkable = node->get_shrinkable() )
+                    path.push_back( std::format( "{} = {}", node->get_name(), shrinkable->current_value_as_string() ) );
+                else
+                    path.push_back( node->get_name() );
+            }
+        }
+        auto message = std::format( "Test timed out after {}. Last assertion started at {}:{}",
+            time_limit, last_assertion_location.file_name(), last_assertion_location.line() );
+        if( !path.empty() )
+            message += std::format( ", in: {}", std::views::reverse( path ) | std::views::join_with( std::string_view(" > ") ) | std::ranges::to<std::string>() );
+
+        AssertionContext context{
+            .macro_name = "",
+            .original_expression = "* test timed out *",
+            .message = message,
+            .location = last_assertion_location };
+        current_context = context;
+        current_result_disposition = ResultDisposition::Abort;
+        reporter.on_assertion_start( context );
+        if( on_assertion_result( ResultType::Failed ) == ResultDetailNeeded::Yes )
+            on_assertion_result_detail( {}, message );
+        current_context.reset();
+    }
+
     auto get_execution_nodes_from_result_handler(ResultHandler& handler) -> ExecutionNodes& {
         assert(dynamic_cast<TestResultHandler*>(&handler) != nullptr);
         auto execution_nodes = static_cast<TestResultHandler&>(handler).get_execution_nodes(); // NOLINT
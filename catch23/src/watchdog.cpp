@@ -0,0 +1,73 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/watchdog.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace CatchKit::Detail {
+
+    Watchdog::Watch::Watch( Watch&& other ) noexcept
+    :   watchdog( std::exchange( other.watchdog, nullptr ) ),
+        id( other.id )
+    {}
+    auto Watchdog::Watch::operator=( Watch&& other ) noexcept -> Watch& {
+        if( this != &other ) {
+            cancel();
+            watchdog = std::exchange( other.watchdog, nullptr );
+            id = other.id;
+        }
+        return *this;
+    }
+    Watchdog::Watch::~Watch() {
+        cancel();
+    }
+    void Watchdog::Watch::cancel() {
+        if( watchdog )
+            std::exchange( watchdog, nullptr )->cancel( id );
+    }
+
+    auto Watchdog::watch( Clock::duration time_limit, std::function<void()> on_expiry ) -> Watch {
+        std::scoped_lock lock( mutex );
+        if( !thread.joinable() )
+            thread = std::jthread( [this]( std::stop_token stop ) { watch_deadlines( stop ); } );
+
+        auto id = next_id++;
+        deadlines.emplace( id, Deadline{ Clock::now() + time_limit, std::move( on_expiry ) } );
+        ++generation;
+        deadlines_changed.notify_one();
+        return { *this, id };
+    }
+
+    void Watchdog::cancel( std::uint64_t id ) {
+        std::scoped_lock lock( mutex );
+        if( deadlines.erase( id ) != 0 ) {
+            ++generation;
+            deadlines_changed.notify_one();
+        }
+    }
+
+    void Watchdog::watch_deadlines( std::stop_token stop ) {
+        std::unique_lock lock( mutex );
+        while( !stop.stop_requested() ) {
+            auto seen_generation = generation;
+            auto has_changed = [&] { return generation != seen_generation; };
+
+            if( deadlines.empty() ) {
+                deadlines_changed.wait( lock, stop, has_changed );
+                continue;
+            }
+            auto earliest = std::ranges::min_element( deadlines, {}, []( auto const& entry ) { return entry.second.expires_at; } );
+            if( earliest->second.expires_at <= Clock::now() ) {
+                auto on_expiry = std::move( earliest->second.on_expiry );
+                deadlines.erase( earliest );
+                on_expiry();
+                continue;
+            }
+            deadlines_changed.wait_until( lock, stop, earliest->second.expires_at, has_changed );
+        }
+    }
+
+} // namespace CatchKit::Detail
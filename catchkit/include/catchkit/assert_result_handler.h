@@ -20,7 +20,7 @@ namespace CatchKit::Detail {
 
         void on_assertion_start( ResultDisposition result_disposition, AssertionContext const& context ) override;
         [[nodiscard]] auto on_assertion_result( ResultType result ) -> ResultDetailNeeded override;
-        void on_assertion_result_detail( ExpressionInfo const& expression_info, std::string_view message ) override;
+        void on_assertion_result_detail( ExpressionInfo&& expression_info, std::string_view message ) override;
         void on_assertion_end() override;
     };
 
@@ -15,6 +15,8 @@
 #include "variable_capture_ref.h" // NOLINT (misc-include-cleaner)
 #include "macros.h" // NOLINT (misc-include-cleaner)
 
+#include <atomic>
+#include <cstddef>
 #include <utility>
 #include <cassert>
 #include <sstream>
@@ -31,10 +33,40 @@ namespace CatchKit::Detail
         bool should_decompose = true;
         std::optional<std::ostringstream> message_stream = {};
 
+        // Set by a test runner when passing assertions don't need to be seen one at a time.
+        // While it points to true they are just counted, in fast_passes (see CATCHKIT_CONFIG_FAST_PASS)
+        std::atomic<bool> const* fast_pass = nullptr;
+        std::size_t fast_passes = 0;
+
         auto check(AssertionContext const& context, InvertResult invert_result=InvertResult::No) -> Asserter;
         auto require(AssertionContext const& context, InvertResult invert_result=InvertResult::No) -> Asserter;
+
+        // Passes on any passes counted so far, so the handler sees them in order with everything else
+        void flush_fast_passes() {
+            if( fast_passes != 0 ) {
+                result_handler->on_fast_passes( fast_passes );
+                fast_passes = 0;
+            }
+        }
     };
 
+    // Evaluates an assertion as a plain bool and, if it passes (and nobody needs to see it), just counts it.
+    // Anything else (including an exception) is left to the slow path, which evaluates the expression again
+    auto passes_fast( Checker& checker, InvertResult invert_result, auto const& expr_call ) noexcept -> bool {
+        if( !checker.fast_pass || !checker.fast_pass->load( std::memory_order_relaxed ) )
+            return false;
+        try {
+            if( expr_call() != (invert_result == InvertResult::Yes) ) [[likely]] {
+                ++checker.fast_passes;
+                return true;
+            }
+        }
+        catch( ... ) { // NOSONAR NOLINT (misc-typo)
+            // reported by the slow path
+        }
+        return false;
+    }
+
     inline auto to_result_type( ResultType result ) -> ResultType { return result; }
     auto to_result_type( MatchResult const& result ) -> ResultType; // Implemented in internal_matchers.h
 
@@ -115,7 +147,7 @@ namespace CatchKit::Detail
     }
     template<typename T>
     auto UnaryExprRef<T>::expand(ResultType) const -> ExpressionInfo {
-        return UnaryExpressionInfo{ stringify(value) };
+        return UnaryExpressionInfo{ stringify_once(value) };
     }
 
     CATCHKIT_WARNINGS_SUPPRESS_START
@@ -144,8 +176,8 @@ namespace CatchKit::Detail
     template<typename LhsT, typename RhsT, Operators Op>
     auto BinaryExprRef<LhsT, RhsT, Op>::expand(ResultType) const -> ExpressionInfo {
         return BinaryExpressionInfo{
-            std::string( stringify(lhs) ),
-            std::string( stringify(rhs) ),
+            stringify_once(lhs),
+            stringify_once(rhs),
             operator_to_string<Op>() };
     }
 
@@ -158,6 +190,6 @@ namespace CatchKit
 } // namespace CatchKit
 
 // This global instance is used if not using the one passed in to a function locally
-extern constinit CatchKit::Checker catch23_checker; // NOSONAR NOLINT (misc-typo)
+extern constinit thread_local CatchKit::Checker catch23_checker; // NOSONAR NOLINT (misc-typo)
 
 #endif // CATCHKIT_CHECKER_H
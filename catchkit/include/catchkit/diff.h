@@ -0,0 +1,160 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_DIFF_H
+#define CATCHKIT_DIFF_H
+
+#include "stringify.h"
+#include "range_compare.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // A run of elements that are in both sequences, or only in one of them
+    struct DiffRun {
+        enum class Type { Same, Removed, Added };
+        Type type;
+        std::size_t expected_index; // where the run starts, in each sequence
+        std::size_t actual_index;
+        std::size_t length;
+    };
+
+    struct Diff {
+        std::vector<DiffRun> runs; // in order, covering both sequences
+        std::size_t first_difference; // the index (in both) of the first element that differs
+        bool complete; // false if there were too many differences to work them all out
+
+        [[nodiscard]] auto has_differences() const -> bool {
+            return std::ranges::any_of( runs, []( DiffRun const& run ) { return run.type != DiffRun::Type::Same; } );
+        }
+    };
+
+    // Compares elements by index, without diff_sequences needing to be a template
+    struct ElementComparer {
+        void const* context;
+        bool (*equal)( void const* context, std::size_t expected_index, std::size_t actual_index );
+
+        auto operator()( std::size_t expected_index, std::size_t actual_index ) const -> bool {
+            return equal( context, expected_index, actual_index );
+        }
+    };
+
+    // Finds the shortest edit script between two sequences, using Myers' algorithm in linear space.
+    // Memory is proportional to max_edits, not to the sizes. Any common prefix and suffix are skipped first
+    // (starting from common_prefix, if that much is already known), and if more than max_edits are needed
+    // it gives up, with everything after the first difference as a single change
+    auto diff_sequences( std::size_t expected_size, std::size_t actual_size, ElementComparer equal, std::size_t max_edits = 1'000, std::size_t common_prefix = 0 ) -> Diff;
+
+    template<typename EqualFn>
+    auto diff_sequences( std::size_t expected_size, std::size_t actual_size, EqualFn const& equal, std::size_t max_edits = 1'000, std::size_t common_prefix = 0 ) -> Diff {
+        return diff_sequences( expected_size, actual_size, ElementComparer{
+            &equal,
+            []( void const* context, std::size_t expected_index, std::size_t actual_index ) {
+                return static_cast<bool>( (*static_cast<EqualFn const*>( context ))( expected_index, actual_index ) );
+            } },
+            max_edits, common_prefix );
+    }
+
+    using ElementRenderer = std::function<std::string( bool from_expected, std::size_t index )>;
+
+    // Renders the first few hunks of a diff, an element per line: "- " if only expected, "+ " if only actual
+    auto render_diff_lines( Diff const& diff, ElementRenderer const& render_element ) -> std::string;
+
+    // As render_diff_lines, for windows of two sequences that start at offset in both (render_element is given
+    // indices within the windows). If the windows end before the sequences do, any changes after the last elements
+    // they have in common are left out, as they may only be because of where the windows end
+    auto render_windowed_diff( std::size_t offset, std::size_t expected_size, std::size_t actual_size, ElementComparer equal, ElementRenderer const& render_element, bool truncated ) -> std::string;
+
+    template<typename EqualFn>
+    auto render_windowed_diff( std::size_t offset, std::size_t expected_size, std::size_t actual_size, EqualFn const& equal, ElementRenderer const& render_element, bool truncated ) -> std::string {
+        return render_windowed_diff( offset, expected_size, actual_size, ElementComparer{
+            &equal,
+            []( void const* context, std::size_t expected_index, std::size_t actual_index ) {
+                return static_cast<bool>( (*static_cast<EqualFn const*>( context ))( expected_index, actual_index ) );
+            } },
+            render_element, truncated );
+    }
+
+    // Renders the first few hunks of a diff between two strings within a line, as "abc[-x-]{+y+}def"
+    auto render_diff_inline( Diff const& diff, std::string_view expected, std::string_view actual ) -> std::string;
+
+    auto split_lines( std::string_view text ) -> std::vector<std::string_view>;
+
+    // Gives access to the elements of a range by index - directly, if it's random access, or else through an index
+    template<typename R>
+    auto index_elements( R const& range ) {
+        using Reference = std::ranges::range_reference_t<R const>;
+        if constexpr( std::ranges::random_access_range<R const> ) {
+            return [&range]( std::size_t index ) -> Reference {
+                return std::ranges::begin( range )[static_cast<std::ranges::range_difference_t<R const>>( index )];
+            };
+        }
+        else if constexpr( std::is_lvalue_reference_v<Reference> ) {
+            std::vector<std::remove_reference_t<Reference>*> elements;
+            for( auto& element : range )
+                elements.push_back( &element );
+            return [elements = std::move( elements )]( std::size_t index ) -> Reference { return *elements[index]; };
+        }
+        else {
+            auto elements = range | std::ranges::to<std::vector<std::ranges::range_value_t<R const>>>();
+            return [elements = std::move( elements )]( std::size_t index ) -> auto const& { return elements[index]; };
+        }
+    }
+
+    // Describes how actual differs from expected, element by element (or is empty if it doesn't)
+    template<typename Expected, typename Actual>
+    auto describe_range_mismatch( Expected const& expected, Actual const& actual ) -> std::string {
+        auto expected_at = index_elements( expected );
+        auto actual_at = index_elements( actual );
+        std::size_t common_prefix = 0;
+        if constexpr( BytewiseComparableRanges<Expected, Actual> )
+            common_prefix = first_mismatch( expected, actual );
+        auto diff = diff_sequences( std::ranges::size( expected ), std::ranges::size( actual ),
+            [&]( std::size_t expected_index, std::size_t actual_index ) {
+                return expected_at( expected_index ) == actual_at( actual_index );
+            },
+            1'000, common_prefix );
+        if( !diff.has_differences() )
+            return {};
+        return render_diff_lines( diff, [&]( bool from_expected, std::size_t index ) {
+            return from_expected ? stringify( expected_at( index ) ) : stringify( actual_at( index ) );
+        } );
+    }
+
+    // Describes how actual differs from expected - by line, if either has more than one, otherwise by character
+    template<typename CasePolicy>
+    auto describe_string_mismatch( std::string_view expected, std::string_view actual ) -> std::string {
+        if( expected.contains( '\n' ) || actual.contains( '\n' ) ) {
+            auto expected_lines = split_lines( expected );
+            auto actual_lines = split_lines( actual );
+            auto diff = diff_sequences( expected_lines.size(), actual_lines.size(),
+                [&]( std::size_t expected_index, std::size_t actual_index ) {
+                    return CasePolicy::equal( expected_lines[expected_index], actual_lines[actual_index] );
+                } );
+            if( !diff.has_differences() )
+                return {};
+            return render_diff_lines( diff, [&]( bool from_expected, std::size_t index ) {
+                return std::string( from_expected ? expected_lines[index] : actual_lines[index] );
+            } );
+        }
+        auto diff = diff_sequences( expected.size(), actual.size(),
+            [&]( std::size_t expected_index, std::size_t actual_index ) {
+                return CasePolicy::equal( expected.substr( expected_index, 1 ), actual.substr( actual_index, 1 ) );
+            } );
+        if( !diff.has_differences() )
+            return {};
+        return render_diff_inline( diff, expected, actual );
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_DIFF_H
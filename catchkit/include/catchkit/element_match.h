@@ -0,0 +1,126 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_ELEMENT_MATCH_H
+#define CATCHKIT_ELEMENT_MATCH_H
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // How all_match, any_match and none_match decide, from whether their matcher matched each element
+    enum class Quantifier { All, Any, None };
+
+    template<Quantifier Q>
+    constexpr std::string_view quantifier_name =
+        Q == Quantifier::All ? "all_match" : Q == Quantifier::Any ? "any_match" : "none_match";
+
+    // Whether the elements of large, random access, ranges may be matched on several threads at once
+    // (so the matcher must be safe to call like that)
+    enum class InParallel { No, Yes };
+
+    // How many of the elements that caused a failure are reported
+    inline constexpr std::size_t max_reported_elements = 5;
+
+    // Smaller ranges aren't worth starting threads for
+    inline constexpr std::size_t parallel_elements_threshold = 64 * 1024;
+    inline constexpr std::size_t parallel_chunk_size = 4 * 1024;
+
+    // The elements that are reported are the ones that didn't match - except for none_match, where it's the ones that did
+    template<Quantifier Q>
+    constexpr auto is_reported( bool matched ) -> bool {
+        return Q == Quantifier::None ? matched : !matched;
+    }
+
+    // Goes through the elements until the outcome is known, calling report( index, element, matched ) for (up to
+    // max_reported_elements of) the ones that caused a failure. So all_match and none_match stop once they have
+    // enough of those, and any_match stops at the first element that matches
+    template<Quantifier Q, typename R>
+    auto match_elements( R&& range, auto const& matches, auto const& report ) -> bool {
+        std::size_t reported = 0;
+        std::size_t index = 0;
+        for( auto&& element : range ) {
+            bool const matched = matches( element );
+            if( Q == Quantifier::Any && matched )
+                return true;
+            if( is_reported<Q>( matched ) && reported < max_reported_elements ) {
+                report( index, element, matched );
+                if( ++reported == max_reported_elements && Q != Quantifier::Any )
+                    return false;
+            }
+            ++index;
+        }
+        return Q == Quantifier::Any ? false : reported == 0;
+    }
+
+    // As match_elements, but the range is split into chunks that are matched across threads. The chunks are started
+    // in order, and every one that's started is finished, so the elements reported are still the first ones (and are
+    // reported from this thread, once the others have finished)
+    template<Quantifier Q, std::ranges::random_access_range R>
+        requires std::ranges::sized_range<R>
+    auto match_elements_in_parallel( R&& range, auto const& matches, auto const& report ) -> bool {
+        auto const size = static_cast<std::size_t>( std::ranges::size( range ) );
+        auto const chunk_count = ( size + parallel_chunk_size - 1 ) / parallel_chunk_size;
+        std::vector<std::vector<std::size_t>> reported_by_chunk( chunk_count );
+        std::atomic<std::size_t> reported = 0;
+        std::atomic<bool> any_matched = false;
+
+        auto const chunks_done = for_each_chunk_in_parallel( chunk_count, [&]( std::size_t chunk ) -> bool {
+            auto const begin = chunk * parallel_chunk_size;
+            auto const end = (std::min)( begin + parallel_chunk_size, size );
+            auto it = std::ranges::begin( range ) + static_cast<std::ranges::range_difference_t<R>>( begin );
+            auto& chunk_reported = reported_by_chunk[chunk];
+            for( auto index = begin; index < end; ++index, ++it ) {
+                bool const matched = matches( *it );
+                if( Q == Quantifier::Any && matched ) {
+                    any_matched = true;
+                    return true;
+                }
+                if( is_reported<Q>( matched ) && chunk_reported.size() < max_reported_elements ) {
+                    chunk_reported.push_back( index );
+                    if( chunk_reported.size() == max_reported_elements && Q != Quantifier::Any )
+                        break;
+                }
+            }
+            // Once there are enough to report, no more chunks are started (but earlier ones, that may have some, are finished)
+            return Q != Quantifier::Any
+                && reported.fetch_add( chunk_reported.size() ) + chunk_reported.size() >= max_reported_elements;
+        } );
+        if( any_matched )
+            return true;
+
+        std::size_t reported_so_far = 0;
+        for( std::size_t chunk = 0; chunk < chunks_done; ++chunk ) {
+            for( auto index : reported_by_chunk[chunk] ) {
+                if( reported_so_far == max_reported_elements )
+                    return false;
+                report( index, std::ranges::begin( range )[static_cast<std::ranges::range_difference_t<R>>( index )], Q == Quantifier::None );
+                ++reported_so_far;
+            }
+        }
+        return Q != Quantifier::Any && reported_so_far == 0;
+    }
+
+    template<Quantifier Q, typename R>
+    auto match_elements( R&& range, auto const& matches, auto const& report, InParallel in_parallel ) -> bool {
+        if constexpr( std::ranges::random_access_range<R> && std::ranges::sized_range<R> ) {
+            if( in_parallel == InParallel::Yes
+                    && static_cast<std::size_t>( std::ranges::size( range ) ) >= parallel_elements_threshold
+                    && parallel_thread_count() > 1 )
+                return match_elements_in_parallel<Q>( range, matches, report );
+        }
+        return match_elements<Q>( range, matches, report );
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_ELEMENT_MATCH_H
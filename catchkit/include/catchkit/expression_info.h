@@ -33,6 +33,7 @@ namespace CatchKit {
         std::string matcher;
 
         std::vector<SubExpressionInfo> sub_expressions;
+        std::string mismatch; // how the value differs from what was expected, if the matcher can say (may be multi-line)
     };
     struct ExceptionExpressionInfo {
         std::string exception_message;
@@ -0,0 +1,167 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_FLOAT_COMPARE_H
+#define CATCHKIT_FLOAT_COMPARE_H
+
+#include "stringify.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // The floating point types that ranges can be compared in bulk for (and whose ulps can be counted
+    // through an integer of the same size)
+    template<typename T>
+    concept FloatOrDouble = std::same_as<T, float> || std::same_as<T, double>;
+
+    // Maps the bits of floating point values to integers in the same order, so the distance between them is in ulps
+    // (and -0.0 and 0.0 are both 0)
+    template<FloatOrDouble T>
+    auto to_ordered_bits( T value ) {
+        using Int = std::conditional_t<sizeof(T) == sizeof(std::int32_t), std::int32_t, std::int64_t>;
+        using UInt = std::make_unsigned_t<Int>;
+        auto const bits = std::bit_cast<Int>( value );
+        // Negative values have the sign bit set, and the rest of the bits get bigger as the value gets more negative
+        return bits < 0
+            ? static_cast<Int>( static_cast<UInt>( (std::numeric_limits<Int>::min)() ) - static_cast<UInt>( bits ) )
+            : bits;
+    }
+
+    template<FloatOrDouble T>
+    auto ulp_distance( T lhs, T rhs ) -> std::uint64_t {
+        auto const lhs_bits = to_ordered_bits( lhs );
+        auto const rhs_bits = to_ordered_bits( rhs );
+        using UInt = std::make_unsigned_t<decltype( lhs_bits )>;
+        return lhs_bits > rhs_bits
+            ? static_cast<UInt>( lhs_bits ) - static_cast<UInt>( rhs_bits )
+            : static_cast<UInt>( rhs_bits ) - static_cast<UInt>( lhs_bits );
+    }
+
+    // Tolerances for comparing ranges, as for IsCloseToAbs, IsCloseToRel and IsWithinUlp.
+    // within() is branch-free, so the loops that call it can be vectorised.
+    // amount() is the margin, epsilon or ulps the tolerance was made with, for describing it
+    struct AbsoluteTolerance {
+        static constexpr std::string_view name = "all_close_to";
+        static constexpr std::string_view units = "";
+        double margin;
+
+        [[nodiscard]] auto amount() const { return margin; }
+        void validate() const {
+            if( margin < 0 )
+                throw std::domain_error( "margin must be positive" );
+        }
+        [[nodiscard]] auto within( double expected, double actual ) const -> bool {
+            return ( actual + margin >= expected ) & ( expected + margin >= actual );
+        }
+        [[nodiscard]] auto error( double expected, double actual ) const -> double {
+            return std::fabs( actual - expected );
+        }
+    };
+    struct RelativeTolerance {
+        static constexpr std::string_view name = "all_close_to_rel";
+        static constexpr std::string_view units = "";
+        double epsilon;
+
+        [[nodiscard]] auto amount() const { return epsilon; }
+        void validate() const {
+            if( epsilon < 0 || epsilon >= 1 )
+                throw std::domain_error( "epsilon must be positive and < 1" );
+        }
+        [[nodiscard]] auto within( double expected, double actual ) const -> bool {
+            auto rel_margin = epsilon * (std::max)( std::fabs( actual ), std::fabs( expected ) );
+            auto margin = rel_margin == std::numeric_limits<double>::infinity() ? 0.0 : rel_margin;
+            return ( actual + margin >= expected ) & ( expected + margin >= actual );
+        }
+        [[nodiscard]] auto error( double expected, double actual ) const -> double {
+            return std::fabs( actual - expected );
+        }
+    };
+    struct UlpTolerance {
+        static constexpr std::string_view name = "all_within_ulp";
+        static constexpr std::string_view units = " ulps";
+        std::uint64_t ulps;
+
+        [[nodiscard]] auto amount() const { return ulps; }
+        void validate() const {}
+        template<FloatOrDouble T>
+        [[nodiscard]] auto within( T expected, T actual ) const -> bool {
+            // NaNs aren't equal to themselves, and aren't within any distance of anything
+            return ( expected == actual )
+                | ( ( expected == expected ) & ( actual == actual ) & ( ulp_distance( expected, actual ) <= ulps ) );
+        }
+        template<FloatOrDouble T>
+        [[nodiscard]] auto error( T expected, T actual ) const -> double {
+            if( std::isnan( expected ) || std::isnan( actual ) )
+                return std::numeric_limits<double>::quiet_NaN();
+            return static_cast<double>( ulp_distance( expected, actual ) );
+        }
+    };
+
+    // How many elements of actual are not within tolerance of expected (which must be the same size).
+    // Compiled for AVX2 as well, which is used if the CPU has it (defined, for each tolerance, in float_compare.cpp)
+    template<FloatOrDouble T, typename Tolerance>
+    auto count_out_of_tolerance( std::span<T const> expected, std::span<T const> actual, Tolerance tolerance ) -> std::size_t;
+
+    // How many of the worst elements describe_out_of_tolerance lists
+    inline constexpr std::size_t max_reported_out_of_tolerance = 5;
+
+    // Counts the elements that are out of tolerance, then lists the worst of them (by error), with their indices
+    template<FloatOrDouble T, typename Tolerance>
+    auto describe_out_of_tolerance( std::span<T const> expected, std::span<T const> actual, Tolerance tolerance ) -> std::string {
+        if( expected.size() != actual.size() )
+            return std::format( "expected {} elements, but there were {}", expected.size(), actual.size() );
+
+        struct OutOfTolerance {
+            std::size_t index;
+            double error; // NaN errors are the worst of all
+        };
+        auto worse = []( OutOfTolerance const& lhs, OutOfTolerance const& rhs ) {
+            if( std::isnan( lhs.error ) || std::isnan( rhs.error ) )
+                return !std::isnan( rhs.error );
+            return lhs.error > rhs.error;
+        };
+
+        // Kept as a heap with the least bad at the top, so it's the one to go when there are too many
+        std::vector<OutOfTolerance> worst;
+        std::size_t count = 0;
+        for( std::size_t i = 0; i < expected.size(); ++i ) {
+            if( tolerance.within( expected[i], actual[i] ) )
+                continue;
+            ++count;
+            worst.push_back( { i, tolerance.error( expected[i], actual[i] ) } );
+            std::ranges::push_heap( worst, worse );
+            if( worst.size() > max_reported_out_of_tolerance ) {
+                std::ranges::pop_heap( worst, worse );
+                worst.pop_back();
+            }
+        }
+        if( count == 0 )
+            return {};
+        std::ranges::sort_heap( worst, worse );
+
+        auto description = std::format( "{} of {} elements out of tolerance. The worst:", count, expected.size() );
+        for( auto const& [index, element_error] : worst ) {
+            std::format_to( std::back_inserter( description ), "\n  [{}] expected {}, actual {} (off by {}{})",
+                index, stringify( expected[index] ), stringify( actual[index] ), stringify( element_error ), Tolerance::units );
+        }
+        return description;
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_FLOAT_COMPARE_H
@@ -56,6 +56,26 @@ namespace CatchKit {
             auto make_child_of( auto const& matcher ) -> CompositeMatchResult&& { return make_child_of( std::bit_cast<uintptr_t>( matcher ) ); }
         };
 
+        // A match result that may already describe the value, and how it differed, as they were worked out while
+        // matching - for values that can't be looked at again afterwards, such as ranges that can only be read once.
+        // Either can be left empty, to be worked out as usual
+        struct DescribedMatchResult : MatchResult {
+            std::string mismatch;
+            std::string value;
+
+            using MatchResult::MatchResult;
+            DescribedMatchResult( bool result, std::string mismatch, std::string value )
+            : MatchResult( result ), mismatch( std::move( mismatch ) ), value( std::move( value ) ) {}
+        };
+
+        // A match result for matchers that match each element of a range (all_match, any_match and none_match),
+        // with the elements that decided it, which are reported as sub-expressions
+        struct ElementsMatchResult : DescribedMatchResult {
+            std::vector<SubExpressionInfo> element_results;
+
+            using DescribedMatchResult::DescribedMatchResult;
+        };
+
         struct MatcherDescription {
             std::string description;
 
@@ -86,6 +106,12 @@ namespace CatchKit {
             { m.lazy_match(f) } -> std::convertible_to<MatchResult>;
         };
 
+        // Matchers can optionally say how a value that they failed to match differs from what they expected
+        template<typename M, typename T>
+        concept HasMismatchDescription = requires(M const& m, T const& arg) {
+            { m.describe_mismatch(arg) } -> std::convertible_to<std::string>;
+        };
+
         template<typename M, typename T>
         concept IsEagerBindableMatcher = requires(M m, T arg, AlwaysMatcher matcher) {
             { m.match(arg, matcher) } -> std::convertible_to<MatchResult>;
@@ -295,28 +321,68 @@ namespace CatchKit {
             [[nodiscard]] auto evaluate() const {
                 return invoke_matcher( matcher, arg );
             }
-            [[nodiscard]] auto arg_as_string() const -> std::string {
+            struct DescribedArg {
+                std::string value;
+                std::string mismatch;
+            };
+            template<typename T>
+            [[nodiscard]] auto describe_mismatch( T const& value ) const -> std::string {
+                if constexpr ( HasMismatchDescription<MatcherT, T> ) {
+                    try {
+                        return matcher.describe_mismatch( value );
+                    }
+                    catch(...) { // NOSONAR NOLINT (misc-typo)
+                        // The mismatch is only extra detail, so we can do without it
+                    }
+                }
+                return {};
+            }
+            // Describes the arg, and how it differs from what was expected, unless the result already has.
+            // An arg passed as a lambda (as the macros do) is evaluated once more for this, and both are
+            // described from that same value - so a large value isn't rebuilt, and the diff is of the value shown
+            [[nodiscard]] auto describe_arg( MatchResult const& result, std::string const& known_value = {}, std::string const& known_mismatch = {} ) const -> DescribedArg {
+                DescribedArg described{ known_value, known_mismatch };
+                auto describe = [&]( auto const& value ) {
+                    if( described.value.empty() )
+                        described.value = stringify_once( value );
+                    if( described.mismatch.empty() && !result )
+                        described.mismatch = describe_mismatch( value );
+                };
                 try {
                     if constexpr ( !std::invocable<ArgT> )
-                        return stringify(arg);
-                    else if constexpr (!std::is_void_v<decltype(arg())>)
-                        return stringify(arg());
-                    else
-                        return {};
+                        describe( arg );
+                    else if constexpr ( !std::is_void_v<decltype(arg())> ) {
+                        bool const mismatch_needed = HasMismatchDescription<MatcherT, std::remove_cvref_t<decltype(arg())>>
+                            && known_mismatch.empty() && !result;
+                        if( known_value.empty() || mismatch_needed )
+                            describe( arg() );
+                    }
                 }
                 catch(...) {
-                    return std::format("exception thrown while evaluating matcher: {}", get_current_exception_message() );
+                    if( described.value.empty() )
+                        described.value = std::format("exception thrown while evaluating matcher: {}", get_current_exception_message() );
                 }
+                return described;
             }
-            [[nodiscard]] auto expand( MatchResult const& ) const -> ExpressionInfo {
-                return MatchExpressionInfo{ arg_as_string(), matcher.describe().description, {} };
+            [[nodiscard]] auto expand( MatchResult const& result ) const -> ExpressionInfo {
+                auto [value, mismatch] = describe_arg( result );
+                return MatchExpressionInfo{ std::move(value), matcher.describe().description, {}, std::move(mismatch) };
             }
             [[nodiscard]] auto expand( CompositeMatchResult const& result ) const -> ExpressionInfo {
                 std::vector<SubExpressionInfo> sub_expressions;
                 if constexpr ( IsCompositeMatcher<MatcherT>) {
                     collect_subexpressions(matcher, sub_expressions, result);
                 }
-                return MatchExpressionInfo{ arg_as_string(), matcher.describe().description, std::move(sub_expressions) };
+                auto [value, mismatch] = describe_arg( result );
+                return MatchExpressionInfo{ std::move(value), matcher.describe().description, std::move(sub_expressions), std::move(mismatch) };
+            }
+            [[nodiscard]] auto expand( DescribedMatchResult const& result ) const -> ExpressionInfo {
+                auto [value, mismatch] = describe_arg( result, result.value, result.mismatch );
+                return MatchExpressionInfo{ std::move(value), matcher.describe().description, {}, std::move(mismatch) };
+            }
+            [[nodiscard]] auto expand( ElementsMatchResult const& result ) const -> ExpressionInfo {
+                auto [value, mismatch] = describe_arg( result, result.value, result.mismatch );
+                return MatchExpressionInfo{ std::move(value), matcher.describe().description, result.element_results, std::move(mismatch) };
             }
         };
 
@@ -340,6 +406,8 @@ namespace CatchKit {
 
     using Detail::MatchResult;
     using Detail::CompositeMatchResult;
+    using Detail::DescribedMatchResult;
+    using Detail::ElementsMatchResult;
     using Detail::MatcherDescription;
 
 } // namespace CatchKit
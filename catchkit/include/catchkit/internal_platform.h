@@ -24,4 +24,27 @@
 #  endif
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64)
+#  define CATCHKIT_ARCH_X86_64
+// Functions that use AVX2 (only called once cpu_has_avx2() says they can be)
+#  ifdef _MSC_VER
+#    define CATCHKIT_TARGET_AVX2
+#  else
+#    define CATCHKIT_TARGET_AVX2 __attribute__((target("avx2")))
+#  endif
+#endif
+
+// For kernels that are called from functions compiled for a particular target (like CATCHKIT_TARGET_AVX2),
+// so they're compiled for it too
+#ifdef _MSC_VER
+#  define CATCHKIT_ALWAYS_INLINE __forceinline
+#else
+#  define CATCHKIT_ALWAYS_INLINE [[gnu::always_inline]] inline
+#endif
+
+namespace CatchKit::Detail {
+    // Checked at runtime (through CPUID), as the build may be for CPUs without it
+    auto cpu_has_avx2() -> bool;
+}
+
 #endif // CATCHKIT_INTERNAL_PLATFORM_H
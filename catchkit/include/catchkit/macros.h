@@ -10,7 +10,27 @@
 
 #include "internal_warnings.h"
 
+// If CATCHKIT_CONFIG_FAST_PASS is defined, CHECK and REQUIRE first evaluate the expression as a plain bool.
+// When the runner doesn't need to see passing assertions, a pass is then just counted.
+// Anything else is evaluated again, to decompose it - so only opt in if your assertions have no side effects.
+// (A for, rather than an if, so there is no dangling else, and a trailing << message still works)
+#ifdef CATCHKIT_CONFIG_FAST_PASS
+    #define CATCHKIT_INTERNAL_FAST_PASS(invert_result, ...) \
+        for( bool catchkit_internal_slow_path = !CatchKit::Detail::passes_fast( checker, invert_result, [&]() -> bool { \
+                    CATCHKIT_WARNINGS_SUPPRESS_START \
+                    CATCHKIT_WARNINGS_SUPPRESS_PARENTHESES \
+                    CATCHKIT_WARNINGS_SUPPRESS_SIGN_MISMATCH \
+                    return static_cast<bool>( __VA_ARGS__ ); \
+                    CATCHKIT_WARNINGS_SUPPRESS_END \
+                } ); \
+                catchkit_internal_slow_path; \
+                catchkit_internal_slow_path = false )
+#else
+    #define CATCHKIT_INTERNAL_FAST_PASS(invert_result, ...)
+#endif
+
 #define CATCHKIT_INTERNAL_ASSERT(macro_name, checker_fun, invert_result, ...) \
+    CATCHKIT_INTERNAL_FAST_PASS( invert_result, __VA_ARGS__ ) \
     checker.checker_fun( CatchKit::AssertionContext(macro_name, #__VA_ARGS__), invert_result ) \
         .handle_unexpected_exceptions([&](CatchKit::Detail::Asserter& asserter){ \
             if( checker.should_decompose ) { \
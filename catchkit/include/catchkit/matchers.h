@@ -6,11 +6,17 @@
 #define CATCHKIT_MATCHERS_H
 
 #include "internal_matchers.h"
+#include "diff.h"
+#include "range_compare.h"
+#include "stream_compare.h"
+#include "regex_cache.h"
+#include "float_compare.h"
+#include "element_match.h"
 
 #include <cmath>
-#include <unordered_set>
 #include <ranges>
 #include <set>
+#include <span>
 
 namespace CatchKit {
 
@@ -26,6 +32,11 @@ namespace CatchKit {
     template<class T>
     concept NotARange = NotStringViewable<T> && !std::ranges::sized_range<T>;
 
+    template<class T>
+    concept FloatingPointSpan =
+        std::ranges::contiguous_range<T const> && std::ranges::sized_range<T const>
+        && Detail::FloatOrDouble<std::ranges::range_value_t<T const>>;
+
 
     namespace GenericMatchers {
         template<typename T>
@@ -73,23 +84,42 @@ namespace CatchKit {
 
     namespace RangeMatchers {
 
+        // Ranges that are only read once (or that have no size) are compared as they're read, so whatever describes
+        // them has to be worked out then, too
+        template<typename Range>
+        auto to_described_result( Detail::StreamedComparison&& comparison ) -> Detail::DescribedMatchResult {
+            return { comparison.matched, std::move( comparison.mismatch ), Detail::describe_streamed_value<Range>( comparison.elements_read ) };
+        }
+
         struct InOrder {
-            static auto equals(auto const& range1, auto const& range2 ) {
-                if( std::size(range1) != std::size(range2) )
-                    return false;
-                for( const auto& [e1, e2] : std::views::zip(range1, range2) )
-                    if( e1 != e2 )
+            template<typename R1, typename R2>
+            static auto equals(R1 const& range1, R2 const& range2 ) {
+                if constexpr( Detail::BytewiseComparableRanges<R1, R2> ) {
+                    return Detail::bytewise_equal(range1, range2);
+                }
+                else {
+                    if( std::size(range1) != std::size(range2) )
                         return false;
-                return true;
+                    for( const auto& [e1, e2] : std::views::zip(range1, range2) )
+                        if( e1 != e2 )
+                            return false;
+                    return true;
+                }
+            }
+            static auto equals_streamed(auto const& expected, auto&& actual ) -> Detail::StreamedComparison {
+                return Detail::compare_streamed_in_order( expected, actual );
+            }
+            static auto describe_mismatch(auto const& expected, auto const& actual ) -> std::string {
+                return Detail::describe_range_mismatch( expected, actual );
             }
         };
         struct InAnyOrder {
+            // Each element must appear the same number of times in both
             static auto equals(auto const& range1, auto const& range2 ) {
-                auto set = range2 | std::ranges::to<std::unordered_set>();
-                for( const auto& match_element : range1 )
-                    if( set.erase(match_element) == 0 )
-                        return false;
-                return set.empty();
+                return Detail::equal_in_any_order( range1, range2 );
+            }
+            static auto equals_streamed(auto const& expected, auto&& actual ) -> Detail::StreamedComparison {
+                return Detail::compare_streamed_in_any_order( expected, actual );
             }
         };
 
@@ -97,14 +127,18 @@ namespace CatchKit {
         struct ContainsElement {
             T const& element;
 
-            template<typename Range>
-            [[nodiscard]] auto match(Range const& range) const -> MatchResult {
-                static_assert(std::ranges::sized_range<Range>);
-                for( const auto& match_element : range ) {
-                    if( element == match_element )
-                        return true;
+            template<std::ranges::input_range Range>
+            [[nodiscard]] auto match(Range&& range) const -> Detail::DescribedMatchResult {
+                if constexpr( Detail::StreamedRange<Range> ) {
+                    return to_described_result<Range>( Detail::find_streamed( range, element ) );
+                }
+                else {
+                    for( const auto& match_element : range ) {
+                        if( element == match_element )
+                            return true;
+                    }
+                    return false;
                 }
-                return false;
             }
             [[nodiscard]] auto describe() const -> MatcherDescription {
                 return std::format("contains({})", stringify(element));
@@ -115,13 +149,13 @@ namespace CatchKit {
         struct ContainsRange {
             R const& range;
 
-            template<typename Range>
-            [[nodiscard]] auto match(Range const& match_range) const -> MatchResult {
-                static_assert(std::ranges::sized_range<Range>);
-                auto set = range | std::ranges::to<std::unordered_set>();
-                for( const auto& match_element : match_range )
-                    set.erase(match_element);
-                return set.empty();
+            template<std::ranges::input_range Range>
+            [[nodiscard]] auto match(Range&& match_range) const -> Detail::DescribedMatchResult {
+                // Repeated elements must be repeated (at least) as many times in match_range
+                if constexpr( Detail::StreamedRange<Range> )
+                    return to_described_result<Range>( Detail::contains_streamed_in_any_order( match_range, range ) );
+                else
+                    return Detail::contains_in_any_order( match_range, range );
             }
             [[nodiscard]] auto describe() const -> MatcherDescription {
                 return std::format("contains({})", stringify(range));
@@ -132,15 +166,65 @@ namespace CatchKit {
         struct Equals {
             R const& range;
 
-            template<typename Range>
-            [[nodiscard]] auto match(Range const& match_range) const -> MatchResult {
-                static_assert(std::ranges::sized_range<Range>);
-                return OrderPolicy::equals(range, match_range);
+            template<std::ranges::input_range Range>
+            [[nodiscard]] auto match(Range&& match_range) const -> Detail::DescribedMatchResult {
+                if constexpr( Detail::StreamedRange<Range> )
+                    return to_described_result<Range>( OrderPolicy::equals_streamed(range, match_range) );
+                else
+                    return OrderPolicy::equals(range, match_range);
             }
 
             [[nodiscard]] auto describe() const -> MatcherDescription {
                 return std::format("equals({})", stringify(range));
             }
+            // Streamed ranges are described while they're compared, as they may not be there to read again
+            template<typename Range>
+                requires (!Detail::StreamedRange<Range>)
+                    && requires( R const& expected, Range const& actual ) { OrderPolicy::describe_mismatch( expected, actual ); }
+            [[nodiscard]] auto describe_mismatch(Range const& match_range) const -> std::string {
+                return OrderPolicy::describe_mismatch(range, match_range);
+            }
+        };
+
+        // Matches each element of a range with another matcher (which may be a composite), all as one assertion.
+        // It stops as soon as the outcome is known - except that a failure goes on until the first few elements
+        // that caused it have been found, as they're reported as sub-expressions
+        template<Detail::Quantifier Q, typename M>
+        struct ElementsMatch {
+            M matcher;
+            Detail::InParallel in_parallel = Detail::InParallel::No;
+
+            template<std::ranges::input_range Range>
+            [[nodiscard]] auto match(Range&& range) const -> Detail::ElementsMatchResult {
+                static_assert(Detail::IsEagerMatcher<M const, std::ranges::range_value_t<Range> const&>,
+                    "The matcher must accept the elements of the range");
+
+                Detail::ElementsMatchResult result( false );
+                std::string matcher_description;
+                // A single pass range can't be read again to describe it, so how much of it was read is counted instead
+                constexpr bool is_single_pass = !std::ranges::forward_range<std::remove_reference_t<Range>>;
+                std::size_t elements_read = 0;
+                auto matches = [this, &elements_read]( auto const& element ) -> bool {
+                    if constexpr( is_single_pass )
+                        ++elements_read;
+                    return static_cast<bool>( matcher.match( element ) );
+                };
+                auto report = [&]( std::size_t index, auto const& element, bool matched ) {
+                    if( matcher_description.empty() )
+                        matcher_description = matcher.describe().description;
+                    result.element_results.emplace_back(
+                        std::format("[{}] {} {}", index, Detail::stringify_once(element), matcher_description), matched );
+                };
+                result.result = Detail::match_elements<Q>( std::forward<Range>(range), matches, report, in_parallel );
+                if constexpr( is_single_pass )
+                    result.value = Detail::describe_streamed_value<Range>( elements_read );
+                if( result )
+                    result.element_results.clear();
+                return result;
+            }
+            [[nodiscard]] auto describe() const -> MatcherDescription {
+                return std::format("{}({})", Detail::quantifier_name<Q>, matcher.describe().description);
+            }
         };
     }
 
@@ -152,12 +236,14 @@ namespace CatchKit {
             static bool equal(std::string_view str1, std::string_view str2);
             static bool find(std::string_view str, std::string_view substr);
             static bool matches_regex(std::string const& str, std::string const& regex_str);
+            static auto compile_regex(std::string const& regex_str) -> std::shared_ptr<Detail::CompiledRegex const>;
         };
         struct CaseInsensitive {
             static constexpr std::string name = "CaseInsensitive";
             static bool equal(std::string_view str1, std::string_view str2);
             static bool find(std::string_view str, std::string_view substr);
             static bool matches_regex(std::string const& str, std::string const& regex_str);
+            static auto compile_regex(std::string const& regex_str) -> std::shared_ptr<Detail::CompiledRegex const>;
         };
 
         template<typename CasePolicy=CaseSensitive>
@@ -215,15 +301,20 @@ namespace CatchKit {
             [[nodiscard]] auto describe() const -> MatcherDescription {
                 return std::format("equals<{}>(\"{}\")", CasePolicy::name, match_str);
             }
+            [[nodiscard]] auto describe_mismatch(std::string_view str) const -> std::string {
+                return Detail::describe_string_mismatch<CasePolicy>(match_str, str);
+            }
         };
 
 
         template<typename CasePolicy=CaseSensitive>
         struct MatchesRegex {
             std::string regex_str;
+            // Compiled once, when the matcher is made (or found already compiled, in the cache)
+            std::shared_ptr<Detail::CompiledRegex const> compiled = CasePolicy::compile_regex(regex_str);
 
-            [[nodiscard]] auto match(std::string const& str) const -> MatchResult {
-                return CasePolicy::matches_regex(str, regex_str);
+            [[nodiscard]] auto match(std::string_view str) const -> MatchResult {
+                return Detail::regex_matches(*compiled, str);
             }
             [[nodiscard]] auto describe() const -> MatcherDescription {
                 return std::format("matches_regex<{}>(\"{}\")", CasePolicy::name, regex_str);
@@ -383,6 +474,26 @@ namespace CatchKit {
                 return std::format("is_nan()");
             }
         };
+
+        // Every element of a contiguous range of floating point numbers is within tolerance of the corresponding
+        // expected element. It's all one assertion, and a failure reports how many were out, and the worst few
+        template<Detail::FloatOrDouble T, typename Tolerance>
+        struct AllWithin {
+            std::span<T const> expected;
+            Tolerance tolerance;
+
+            [[nodiscard]] auto match( std::span<T const> actual ) const -> MatchResult {
+                tolerance.validate();
+                return actual.size() == expected.size()
+                    && Detail::count_out_of_tolerance( expected, actual, tolerance ) == 0;
+            }
+            [[nodiscard]] auto describe() const -> MatcherDescription {
+                return std::format("{}({}, {})", Tolerance::name, stringify(expected), stringify(tolerance.amount()));
+            }
+            [[nodiscard]] auto describe_mismatch( std::span<T const> actual ) const -> std::string {
+                return Detail::describe_out_of_tolerance( expected, actual, tolerance );
+            }
+        };
     } // namespace FloatMatchers
 
 
@@ -391,6 +502,7 @@ namespace CatchKit {
         using StringMatchers::CaseInsensitive;
         using RangeMatchers::InOrder;
         using RangeMatchers::InAnyOrder;
+        using Detail::InParallel;
 
         auto equals(NotARange auto& value) { return GenericMatchers::Equals{value}; }
 
@@ -441,6 +553,37 @@ namespace CatchKit {
             return FloatMatchers::IsNaN();
         }
 
+        template<FloatingPointSpan R, typename T = std::ranges::range_value_t<R const>>
+        auto all_close_to( R const& expected, double margin = 100*std::numeric_limits<T>::epsilon() ) {
+            return FloatMatchers::AllWithin<T, Detail::AbsoluteTolerance>{ std::span<T const>( expected ), { margin } };
+        }
+        template<FloatingPointSpan R, typename T = std::ranges::range_value_t<R const>>
+        auto all_close_to_rel( R const& expected, double epsilon = 100*std::numeric_limits<T>::epsilon() ) {
+            return FloatMatchers::AllWithin<T, Detail::RelativeTolerance>{ std::span<T const>( expected ), { epsilon } };
+        }
+        template<FloatingPointSpan R, typename T = std::ranges::range_value_t<R const>>
+        auto all_within_ulp( R const& expected, std::uint64_t ulps = 1 ) {
+            return FloatMatchers::AllWithin<T, Detail::UlpTolerance>{ std::span<T const>( expected ), { ulps } };
+        }
+
+        // Each element must match (or, for any_match, at least one must - or, for none_match, none may).
+        // With InParallel::Yes, large random access ranges are matched across threads
+        template<Detail::IsMatcher M>
+        auto all_match(M&& matcher, InParallel in_parallel = InParallel::No) {
+            Detail::enforce_composite_matchers_are_rvalues<M>();
+            return RangeMatchers::ElementsMatch<Detail::Quantifier::All, std::remove_cvref_t<M>>{ std::forward<M>(matcher), in_parallel };
+        }
+        template<Detail::IsMatcher M>
+        auto any_match(M&& matcher, InParallel in_parallel = InParallel::No) {
+            Detail::enforce_composite_matchers_are_rvalues<M>();
+            return RangeMatchers::ElementsMatch<Detail::Quantifier::Any, std::remove_cvref_t<M>>{ std::forward<M>(matcher), in_parallel };
+        }
+        template<Detail::IsMatcher M>
+        auto none_match(M&& matcher, InParallel in_parallel = InParallel::No) {
+            Detail::enforce_composite_matchers_are_rvalues<M>();
+            return RangeMatchers::ElementsMatch<Detail::Quantifier::None, std::remove_cvref_t<M>>{ std::forward<M>(matcher), in_parallel };
+        }
+
         inline auto is_true() { static bool true_value = true; return equals(true_value); }
         inline auto is_false() { static bool false_value = false; return equals(false_value); }
 
@@ -0,0 +1,26 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_PARALLEL_H
+#define CATCHKIT_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace CatchKit::Detail {
+
+    // How many threads for_each_chunk_in_parallel uses (including the calling thread) - at least 1
+    auto parallel_thread_count() -> std::size_t;
+
+    // Calls do_chunk for each chunk index, from 0 up to chunk_count, across up to parallel_thread_count() threads:
+    // this one, and helpers from a pool that every caller shares (so tests running on several threads don't each
+    // start their own).
+    // Chunks are claimed in order, and once do_chunk returns true no more are claimed. Any that already were are
+    // still finished, so the chunks that were done are always 0 up to the returned count.
+    // If do_chunk throws, the first exception is rethrown once the other threads have stopped
+    auto for_each_chunk_in_parallel( std::size_t chunk_count, std::function<bool(std::size_t)> const& do_chunk ) -> std::size_t;
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_PARALLEL_H
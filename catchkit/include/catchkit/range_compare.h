@@ -0,0 +1,391 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_RANGE_COMPARE_H
+#define CATCHKIT_RANGE_COMPARE_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // Types whose values are equal exactly when their bytes are (so not floating point, where -0 == 0 and NaN != NaN)
+    template<typename T>
+    concept BytewiseComparable =
+        ( std::is_integral_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::byte> )
+        && std::has_unique_object_representations_v<T>;
+
+    // Ranges that can be compared with memcmp, instead of element by element
+    template<typename R1, typename R2>
+    concept BytewiseComparableRanges =
+        std::ranges::contiguous_range<R1 const> && std::ranges::contiguous_range<R2 const>
+        && std::ranges::sized_range<R1 const> && std::ranges::sized_range<R2 const>
+        && std::same_as<std::ranges::range_value_t<R1 const>, std::ranges::range_value_t<R2 const>>
+        && BytewiseComparable<std::ranges::range_value_t<R1 const>>;
+
+    template<typename R1, typename R2> requires BytewiseComparableRanges<R1, R2>
+    auto bytewise_equal( R1 const& range1, R2 const& range2 ) -> bool {
+        using T = std::ranges::range_value_t<R1 const>;
+        auto const size = std::ranges::size( range1 );
+        return size == std::ranges::size( range2 )
+            && ( size == 0 || std::memcmp( std::ranges::data( range1 ), std::ranges::data( range2 ), size * sizeof(T) ) == 0 );
+    }
+
+    // The index of the first element that differs (or the size of the shorter range, if there isn't one).
+    // memcmp finds the block it's in, then only that block is compared element by element
+    template<typename R1, typename R2> requires BytewiseComparableRanges<R1, R2>
+    auto first_mismatch( R1 const& range1, R2 const& range2 ) -> std::size_t {
+        using T = std::ranges::range_value_t<R1 const>;
+        constexpr std::size_t block_size = (std::max)( std::size_t{ 4096 } / sizeof(T), std::size_t{ 1 } );
+
+        auto const size = (std::min)( std::ranges::size( range1 ), std::ranges::size( range2 ) );
+        auto const* data1 = std::ranges::data( range1 );
+        auto const* data2 = std::ranges::data( range2 );
+        std::size_t start = 0;
+        while( size - start > block_size && std::memcmp( data1 + start, data2 + start, block_size * sizeof(T) ) == 0 )
+            start += block_size;
+        return static_cast<std::size_t>( std::mismatch( data1 + start, data1 + size, data2 + start, data2 + size ).first - data1 );
+    }
+
+    // Ranges that are compared as they're read, in one pass - as they can only be read once (or only when they're
+    // not const), or don't know their size up front. Only the range they're compared with is held in memory
+    template<typename R>
+    concept StreamedRange =
+        std::ranges::input_range<R>
+        && !( std::ranges::forward_range<std::remove_reference_t<R> const> && std::ranges::sized_range<std::remove_reference_t<R> const> );
+
+    template<typename T>
+    concept Hashable = requires( T const& value ) {
+        { std::hash<T>{}( value ) } -> std::convertible_to<std::size_t>;
+    };
+
+    // How to compare ranges while ignoring the order of their elements (but not how many times each appears)
+    enum class UnorderedStrategy {
+        Quadratic, // count each element in both ranges: no allocations, so best for small ranges (and works for any type)
+        Sorted, // sort both, then merge
+        Hashed // count the elements of one range in a hash map, then count them off against the other
+    };
+
+    // Up to this many elements, comparing every pair beats building anything to compare them
+    inline constexpr std::size_t small_range_size = 16;
+
+    // Elements of different types (e.g. int and long) are hashed or sorted as their common type
+    template<typename T1, typename T2>
+    concept HaveCommonType =
+        requires { typename std::common_type_t<T1, T2>; }
+        && std::convertible_to<T1 const&, std::common_type_t<T1, T2>>
+        && std::convertible_to<T2 const&, std::common_type_t<T1, T2>>;
+
+    template<typename R1, typename R2>
+    using CommonElement = std::common_type_t<std::ranges::range_value_t<R1 const>, std::ranges::range_value_t<R2 const>>;
+
+    template<typename R1, typename R2>
+    constexpr auto choose_unordered_strategy( std::size_t size ) -> UnorderedStrategy {
+        using enum UnorderedStrategy;
+        if constexpr( !HaveCommonType<std::ranges::range_value_t<R1 const>, std::ranges::range_value_t<R2 const>> ) {
+            return Quadratic;
+        }
+        else {
+            using T = CommonElement<R1, R2>;
+            if( size <= small_range_size )
+                return Quadratic;
+            // Values that are cheap to copy sort faster than they hash. Floating point isn't, as NaNs break sorting
+            if constexpr( std::totally_ordered<T> && std::is_trivially_copyable_v<T> && !std::floating_point<T> )
+                return Sorted;
+            else if constexpr( Hashable<T> )
+                return Hashed;
+            else if constexpr( std::totally_ordered<T> )
+                return Sorted;
+            else
+                return Quadratic;
+        }
+    }
+
+    // The elements of a range, copied if they're small and trivial to copy, otherwise referred to by pointer
+    template<typename T, bool ByPointer>
+    struct CollectedElements {
+        std::vector<std::conditional_t<ByPointer, T const*, T>> elements;
+
+        static auto get( T const& value ) -> T const& { return value; }
+        static auto get( T const* const& element ) -> T const& requires ByPointer { return *element; }
+
+        // Hashes and compares stored elements, or elements of the other range, alike
+        struct Hash {
+            using is_transparent = void;
+            auto operator()( auto const& element ) const -> std::size_t { return std::hash<T>{}( get( element ) ); }
+        };
+        struct Equal {
+            using is_transparent = void;
+            auto operator()( auto const& lhs, auto const& rhs ) const -> bool { return get( lhs ) == get( rhs ); }
+        };
+    };
+
+    // Elements are converted to T (so copied) if they're not already of that type
+    template<typename T, typename R>
+    auto collect_elements_as( R const& range ) {
+        constexpr bool by_pointer =
+            std::same_as<T, std::ranges::range_value_t<R const>>
+            && std::is_lvalue_reference_v<std::ranges::range_reference_t<R const>>
+            && !( std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*) );
+
+        CollectedElements<T, by_pointer> collected;
+        collected.elements.reserve( static_cast<std::size_t>( std::ranges::distance( range ) ) );
+        for( auto const& element : range ) {
+            if constexpr( by_pointer )
+                collected.elements.push_back( &element );
+            else
+                collected.elements.push_back( static_cast<T>( element ) );
+        }
+        return collected;
+    }
+    template<typename R>
+    auto collect_elements( R const& range ) {
+        return collect_elements_as<std::ranges::range_value_t<R const>>( range );
+    }
+
+    template<typename Collected>
+    void sort_collected( Collected& collected ) {
+        std::ranges::sort( collected.elements, std::ranges::less{}, []( auto const& element ) -> auto const& { return Collected::get( element ); } );
+    }
+
+    // How many times each element of a range appears in it (as a T)
+    template<typename T, typename R>
+    auto count_elements_as( R const& range ) {
+        auto collected = collect_elements_as<T>( range );
+        using Collected = decltype( collected );
+        using Stored = typename decltype( collected.elements )::value_type;
+        std::unordered_map<Stored, std::size_t, typename Collected::Hash, typename Collected::Equal> counts;
+        counts.reserve( collected.elements.size() );
+        for( auto& element : collected.elements )
+            ++counts[std::move( element )];
+        return counts;
+    }
+
+    // For each distinct element of needles, how many times it appears in needles, and in haystack (no allocations)
+    template<typename R1, typename R2>
+    auto quadratic_counts_agree( R1 const& needles, R2 const& haystack, auto const& counts_agree ) -> bool {
+        auto const needles_end = std::ranges::end( needles );
+        for( auto it = std::ranges::begin( needles ); it != needles_end; ++it ) {
+            auto const& needle = *it;
+            auto matches = [&needle]( auto const& element ) { return needle == element; };
+            if( std::ranges::find_if( std::ranges::begin( needles ), it, matches ) != it )
+                continue; // already counted
+            auto needle_count = std::ranges::count_if( it, needles_end, matches );
+            auto haystack_count = std::ranges::count_if( haystack, matches );
+            if( !counts_agree( needle_count, haystack_count ) )
+                return false;
+        }
+        return true;
+    }
+
+    // Whether the ranges have the same elements, the same number of times each, in any order
+    template<typename R1, typename R2>
+    auto equal_in_any_order( R1 const& expected, R2 const& actual ) -> bool {
+        auto const size = static_cast<std::size_t>( std::ranges::distance( expected ) );
+        if( size != static_cast<std::size_t>( std::ranges::distance( actual ) ) )
+            return false;
+
+        auto const strategy = choose_unordered_strategy<R1, R2>( size );
+        if constexpr( HaveCommonType<std::ranges::range_value_t<R1 const>, std::ranges::range_value_t<R2 const>> ) {
+            using T = CommonElement<R1, R2>;
+            if( strategy == UnorderedStrategy::Sorted ) {
+                if constexpr( std::totally_ordered<T> ) {
+                    auto expected_elements = collect_elements_as<T>( expected );
+                    auto actual_elements = collect_elements_as<T>( actual );
+                    sort_collected( expected_elements );
+                    sort_collected( actual_elements );
+                    return std::ranges::equal( expected_elements.elements, actual_elements.elements, std::ranges::equal_to{},
+                        []( auto const& element ) -> auto const& { return decltype( expected_elements )::get( element ); },
+                        []( auto const& element ) -> auto const& { return decltype( actual_elements )::get( element ); } );
+                }
+            }
+            else if( strategy == UnorderedStrategy::Hashed ) {
+                if constexpr( Hashable<T> ) {
+                    // The sizes are the same, so if nothing is left over at the end, nothing is missing either
+                    auto counts = count_elements_as<T>( expected );
+                    for( auto const& element : actual ) {
+                        auto it = counts.find( element );
+                        if( it == counts.end() || it->second == 0 )
+                            return false;
+                        --it->second;
+                    }
+                    return true;
+                }
+            }
+        }
+        return quadratic_counts_agree( expected, actual, []( auto n1, auto n2 ) { return n1 == n2; } );
+    }
+
+    // Whether haystack has every element of needles, at least as many times each, in any order
+    template<typename R1, typename R2>
+    auto contains_in_any_order( R1 const& haystack, R2 const& needles ) -> bool {
+        auto const needles_size = static_cast<std::size_t>( std::ranges::distance( needles ) );
+        auto const haystack_size = static_cast<std::size_t>( std::ranges::distance( haystack ) );
+        if( needles_size > haystack_size )
+            return false;
+
+        auto const strategy = choose_unordered_strategy<R2, R1>( haystack_size );
+        if constexpr( HaveCommonType<std::ranges::range_value_t<R2 const>, std::ranges::range_value_t<R1 const>> ) {
+            using T = CommonElement<R2, R1>;
+            if( strategy == UnorderedStrategy::Sorted ) {
+                if constexpr( std::totally_ordered<T> ) {
+                    auto haystack_elements = collect_elements_as<T>( haystack );
+                    auto needle_elements = collect_elements_as<T>( needles );
+                    sort_collected( haystack_elements );
+                    sort_collected( needle_elements );
+                    return std::ranges::includes( haystack_elements.elements, needle_elements.elements, std::ranges::less{},
+                        []( auto const& element ) -> auto const& { return decltype( haystack_elements )::get( element ); },
+                        []( auto const& element ) -> auto const& { return decltype( needle_elements )::get( element ); } );
+                }
+            }
+            else if( strategy == UnorderedStrategy::Hashed ) {
+                if constexpr( Hashable<T> ) {
+                    // Count off the needles as they're found, stopping as soon as they all have been
+                    auto counts = count_elements_as<T>( needles );
+                    auto remaining = needles_size;
+                    for( auto const& element : haystack ) {
+                        if( remaining == 0 )
+                            break;
+                        if( auto it = counts.find( element ); it != counts.end() && it->second != 0 ) {
+                            --it->second;
+                            --remaining;
+                        }
+                    }
+                    return remaining == 0;
+                }
+            }
+        }
+        return quadratic_counts_agree( needles, haystack, []( auto n1, auto n2 ) { return n1 <= n2; } );
+    }
+
+    // The elements of a range, counted off (as Ts) as the same elements are found in a streamed range.
+    // take() says whether the element was still to be found, and for_each_remaining() goes through the
+    // ones that weren't, once for each time they weren't
+    template<typename R, typename T>
+    class HashedRemainingElements {
+        decltype( count_elements_as<T>( std::declval<R const&>() ) ) counts;
+        std::size_t remaining;
+
+    public:
+        explicit HashedRemainingElements( R const& range )
+        :   counts( count_elements_as<T>( range ) ),
+            remaining( static_cast<std::size_t>( std::ranges::distance( range ) ) )
+        {}
+
+        auto take( auto const& element ) -> bool {
+            auto it = counts.find( element );
+            if( it == counts.end() || it->second == 0 )
+                return false;
+            --it->second;
+            --remaining;
+            return true;
+        }
+        [[nodiscard]] auto size() const { return remaining; }
+        void for_each_remaining( auto const& fn ) const {
+            using Collected = decltype( collect_elements_as<T>( std::declval<R const&>() ) );
+            for( auto const& [element, count] : counts )
+                for( std::size_t i = 0; i < count; ++i )
+                    fn( Collected::get( element ) );
+        }
+    };
+
+    template<typename R, typename T>
+    class SortedRemainingElements {
+        using Collected = decltype( collect_elements_as<T>( std::declval<R const&>() ) );
+        Collected collected;
+        std::vector<std::size_t> taken; // from each run of equal elements, by the index it starts at
+        std::size_t remaining;
+
+        static auto get( auto const& element ) -> auto const& { return Collected::get( element ); }
+
+    public:
+        explicit SortedRemainingElements( R const& range )
+        :   collected( collect_elements_as<T>( range ) ),
+            taken( collected.elements.size(), 0 ),
+            remaining( collected.elements.size() )
+        {
+            sort_collected( collected );
+        }
+
+        auto take( auto const& element ) -> bool {
+            // (std::less<T>, rather than std::ranges::less, converts the element, if it needs to)
+            auto [first, last] = std::ranges::equal_range( collected.elements, element, std::less<T>{},
+                []( auto const& stored ) -> auto const& { return get( stored ); } );
+            if( first == last )
+                return false;
+            auto& taken_from_run = taken[static_cast<std::size_t>( first - collected.elements.begin() )];
+            if( taken_from_run == static_cast<std::size_t>( last - first ) )
+                return false;
+            ++taken_from_run;
+            --remaining;
+            return true;
+        }
+        [[nodiscard]] auto size() const { return remaining; }
+        void for_each_remaining( auto const& fn ) const {
+            auto const& elements = collected.elements;
+            for( std::size_t run = 0, run_end = 0; run < elements.size(); run = run_end ) {
+                while( run_end < elements.size() && get( elements[run_end] ) == get( elements[run] ) )
+                    ++run_end;
+                for( auto i = run + taken[run]; i < run_end; ++i )
+                    fn( get( elements[i] ) );
+            }
+        }
+    };
+
+    template<typename R>
+    class QuadraticRemainingElements {
+        using Collected = decltype( collect_elements( std::declval<R const&>() ) );
+        Collected collected;
+        std::vector<bool> taken;
+        std::size_t remaining;
+
+    public:
+        explicit QuadraticRemainingElements( R const& range )
+        :   collected( collect_elements( range ) ),
+            taken( collected.elements.size(), false ),
+            remaining( collected.elements.size() )
+        {}
+
+        auto take( auto const& element ) -> bool {
+            for( std::size_t i = 0; i < collected.elements.size(); ++i ) {
+                if( !taken[i] && Collected::get( collected.elements[i] ) == element ) {
+                    taken[i] = true;
+                    --remaining;
+                    return true;
+                }
+            }
+            return false;
+        }
+        [[nodiscard]] auto size() const { return remaining; }
+        void for_each_remaining( auto const& fn ) const {
+            for( std::size_t i = 0; i < collected.elements.size(); ++i )
+                if( !taken[i] )
+                    fn( Collected::get( collected.elements[i] ) );
+        }
+    };
+
+    // Counting off by hashing or sorting is done with the common type of the elements (and those of the streamed
+    // range, which are Ts), as for choose_unordered_strategy
+    template<typename T, typename R>
+    auto remaining_elements_of( R const& range ) {
+        using Element = std::ranges::range_value_t<R const>;
+        if constexpr( HaveCommonType<Element, T> && Hashable<std::common_type_t<Element, T>> )
+            return HashedRemainingElements<R, std::common_type_t<Element, T>>( range );
+        else if constexpr( HaveCommonType<Element, T> && std::totally_ordered<std::common_type_t<Element, T>> )
+            return SortedRemainingElements<R, std::common_type_t<Element, T>>( range );
+        else
+            return QuadraticRemainingElements<R>( range );
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_RANGE_COMPARE_H
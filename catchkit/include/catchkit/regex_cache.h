@@ -0,0 +1,33 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_REGEX_CACHE_H
+#define CATCHKIT_REGEX_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace CatchKit::Detail {
+
+    // A pattern, compiled for whole-string matching (as std::regex_match).
+    // Patterns that are just text, perhaps with .* at either end (and ^ or $), are matched
+    // by comparing or searching for the text, without std::regex (defined in regex_cache.cpp)
+    struct CompiledRegex;
+
+    // How many compiled patterns are kept, most recently used first
+    inline constexpr std::size_t regex_cache_capacity = 64;
+
+    // Compiles the pattern, unless it's in the (process-wide) cache already. Throws std::regex_error if it's invalid
+    auto get_compiled_regex( std::string const& pattern, bool ignore_case ) -> std::shared_ptr<CompiledRegex const>;
+
+    auto regex_matches( CompiledRegex const& regex, std::string_view str ) -> bool;
+
+    // Whether the pattern is matched without std::regex, at least for strings on a single line
+    auto is_simple_regex( CompiledRegex const& regex ) -> bool;
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_REGEX_CACHE_H
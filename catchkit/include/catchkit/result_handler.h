@@ -9,6 +9,7 @@
 #include "expression_info.h"
 #include "report_on.h"
 
+#include <cstddef>
 #include <string_view>
 
 namespace CatchKit::Detail
@@ -27,9 +28,12 @@ namespace CatchKit::Detail
 
         virtual void on_assertion_start( ResultDisposition result_disposition, AssertionContext const& context ) = 0;
         [[nodiscard]] virtual auto on_assertion_result( ResultType result ) -> ResultDetailNeeded = 0;
-        virtual void on_assertion_result_detail( ExpressionInfo const& expression_info, std::string_view message ) = 0;
+        virtual void on_assertion_result_detail( ExpressionInfo&& expression_info, std::string_view message ) = 0;
         virtual void on_assertion_end() = 0;
 
+        // Assertions that passed without being seen one at a time (see Checker::fast_pass)
+        virtual void on_fast_passes( std::size_t ) { /* do nothing by default */ };
+
         virtual void add_variable_capture(VariableCaptureRef*) { /* do nothing by default */ };
         virtual void remove_variable_capture(VariableCaptureRef*) { /* do nothing by default */ };
 
@@ -0,0 +1,156 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_STREAM_COMPARE_H
+#define CATCHKIT_STREAM_COMPARE_H
+
+#include "diff.h"
+#include "range_compare.h"
+#include "stringify.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    // How many elements of a streamed range are kept, from the first difference on, to describe it
+    inline constexpr std::size_t streamed_window_size = 32;
+
+    // How many of the elements before the first difference are shown (they're the same as the expected ones)
+    inline constexpr std::size_t streamed_context_size = 3;
+
+    // How many missing elements are listed
+    inline constexpr std::size_t max_reported_missing = 5;
+
+    // What comparing a streamed range found, which has to be described then, as it can't be read again
+    struct StreamedComparison {
+        bool matched;
+        std::string mismatch;
+        std::size_t elements_read;
+    };
+
+    // A single pass range can't be stringified once it's been read (and neither can a range that can't be read
+    // while const), so it's described by how much of it was. Other streamed ranges are stringified as usual
+    template<typename R>
+    auto describe_streamed_value( std::size_t elements_read ) -> std::string {
+        using Range = std::remove_reference_t<R>;
+        if constexpr( std::ranges::forward_range<Range const> )
+            return {};
+        else if constexpr( std::ranges::forward_range<Range> )
+            return std::format( "{{ range: {} elements read }}", elements_read );
+        else
+            return std::format( "{{ single pass range: {} elements read }}", elements_read );
+    }
+
+    template<typename Remaining>
+    auto describe_missing( Remaining const& remaining, std::string_view what ) -> std::string {
+        std::string description = std::format( "{} of the {} weren't found:", remaining.size(), what );
+        std::size_t listed = 0;
+        remaining.for_each_remaining( [&]( auto const& element ) {
+            if( listed++ < max_reported_missing )
+                std::format_to( std::back_inserter( description ), "\n  {}", stringify( element ) );
+        } );
+        if( listed > max_reported_missing )
+            std::format_to( std::back_inserter( description ), "\n  ... ({} more)", listed - max_reported_missing );
+        return description;
+    }
+
+    template<typename R, typename T>
+    auto find_streamed( R&& range, T const& element ) -> StreamedComparison {
+        std::size_t elements_read = 0;
+        for( auto&& match_element : range ) {
+            ++elements_read;
+            if( element == match_element )
+                return { true, {}, elements_read };
+        }
+        return { false, {}, elements_read };
+    }
+
+    // Compares as actual is read, in order. Once they differ, only a window of actual is read, to describe it
+    template<typename Expected, typename Actual>
+    auto compare_streamed_in_order( Expected const& expected, Actual&& actual ) -> StreamedComparison {
+        auto expected_it = std::ranges::begin( expected );
+        auto const expected_end = std::ranges::end( expected );
+        auto actual_it = std::ranges::begin( actual );
+        auto const actual_end = std::ranges::end( actual );
+        std::size_t index = 0;
+        for( ; expected_it != expected_end && actual_it != actual_end; ++expected_it, ++actual_it, ++index ) {
+            if( *expected_it != *actual_it )
+                break;
+        }
+        if( expected_it == expected_end && actual_it == actual_end )
+            return { true, {}, index };
+
+        // The elements before the first difference are the same as expected's, so only the ones from there on are kept
+        std::vector<std::ranges::range_value_t<Actual>> actual_window;
+        for( ; actual_it != actual_end && actual_window.size() < streamed_window_size; ++actual_it )
+            actual_window.emplace_back( *actual_it );
+        bool const actual_truncated = actual_it != actual_end;
+
+        auto const expected_size = static_cast<std::size_t>( std::ranges::distance( expected ) );
+        auto const start = index - (std::min)( index, streamed_context_size );
+        auto const expected_window_end = (std::min)( index + streamed_window_size, expected_size );
+        std::vector<std::ranges::range_value_t<Expected const>> expected_window;
+        expected_window.reserve( expected_window_end - start );
+        auto window_it = std::ranges::next( std::ranges::begin( expected ), static_cast<std::ranges::range_difference_t<Expected const>>( start ) );
+        for( auto i = start; i < expected_window_end; ++i, ++window_it )
+            expected_window.emplace_back( *window_it );
+
+        // Within the windows, actual starts with the context before the first difference, which is from expected
+        auto const context = index - start;
+        auto mismatch = render_windowed_diff( start, expected_window.size(), context + actual_window.size(),
+            [&]( std::size_t expected_index, std::size_t actual_index ) -> bool {
+                if( actual_index < context )
+                    return expected_window[expected_index] == expected_window[actual_index];
+                return expected_window[expected_index] == actual_window[actual_index - context];
+            },
+            [&]( bool from_expected, std::size_t i ) -> std::string {
+                if( from_expected || i < context )
+                    return stringify( expected_window[i] );
+                return stringify( actual_window[i - context] );
+            },
+            actual_truncated || expected_window_end < expected_size );
+        return { false, std::move( mismatch ), index + actual_window.size() };
+    }
+
+    // Counts off the elements of expected as actual is read, stopping at the first one that isn't expected
+    template<typename Expected, typename Actual>
+    auto compare_streamed_in_any_order( Expected const& expected, Actual&& actual ) -> StreamedComparison {
+        auto remaining = remaining_elements_of<std::ranges::range_value_t<Actual>>( expected );
+        std::size_t index = 0;
+        for( auto&& element : actual ) {
+            if( !remaining.take( element ) )
+                return { false, std::format( "element {} ({}) isn't expected, or is there more times than expected", index, stringify( element ) ), index + 1 };
+            ++index;
+        }
+        if( remaining.size() == 0 )
+            return { true, {}, index };
+        return { false, describe_missing( remaining, "expected elements" ), index };
+    }
+
+    // Counts off the needles as the haystack is read, stopping as soon as they all have been
+    template<typename Haystack, typename Needles>
+    auto contains_streamed_in_any_order( Haystack&& haystack, Needles const& needles ) -> StreamedComparison {
+        auto remaining = remaining_elements_of<std::ranges::range_value_t<Haystack>>( needles );
+        std::size_t elements_read = 0;
+        auto const haystack_end = std::ranges::end( haystack );
+        for( auto it = std::ranges::begin( haystack ); remaining.size() != 0 && it != haystack_end; ++it ) {
+            remaining.take( *it );
+            ++elements_read;
+        }
+        if( remaining.size() == 0 )
+            return { true, {}, elements_read };
+        return { false, describe_missing( remaining, "elements to look for" ), elements_read };
+    }
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_STREAM_COMPARE_H
@@ -0,0 +1,26 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#ifndef CATCHKIT_STRING_SEARCH_H
+#define CATCHKIT_STRING_SEARCH_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace CatchKit::Detail {
+
+    // Comparing and searching while ignoring (ASCII) case, without making lowered copies.
+    // These use SSE2 or AVX2 where the CPU has them (checked once, at runtime), otherwise the scalar versions
+    auto equal_ignoring_case( std::string_view str1, std::string_view str2 ) -> bool;
+    auto find_ignoring_case( std::string_view str, std::string_view substr ) -> std::size_t; // or npos
+
+    auto equal_ignoring_case_scalar( std::string_view str1, std::string_view str2 ) -> bool;
+    auto find_ignoring_case_scalar( std::string_view str, std::string_view substr ) -> std::size_t;
+
+    // "avx2", "sse2" or "scalar"
+    auto string_search_implementation() -> std::string_view;
+
+} // namespace CatchKit::Detail
+
+#endif // CATCHKIT_STRING_SEARCH_H
@@ -7,9 +7,16 @@
 
 #include "reflection.h"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <ranges>
 #include <string>
 #include <string_view>
 #include <format>
+#include <iterator>
 
 // #define CATCHKIT_FALLBACK_TO_OSTREAM_STRING_CONVERSIONS
 
@@ -44,6 +51,37 @@ namespace CatchKit {
 
     template<typename T>
     [[nodiscard]] auto constexpr stringify(T const& value );
+
+    // Writes the same text as stringify(value), but to out (any output iterator of chars), returning the new end.
+    // Nothing is allocated here for arithmetic types, strings, ranges or anything formattable - only by out, if it grows.
+    // Either way, output stops at the current StringifyLimits
+    template<typename T, typename OutputIt>
+    auto stringify_to(OutputIt out, T const& value ) -> OutputIt;
+
+    // A buffer, per thread, that expansions stringify into - so its capacity is reused from one to the next
+    auto get_stringify_buffer() -> std::string&;
+
+    // How much of a value stringify writes out, so huge containers or strings don't take forever (or all memory).
+    // Whatever is left out is shown as ... A limit of 0 means no limit
+    struct StringifyLimits {
+        std::size_t max_elements = 100; // of each range
+        std::size_t max_chars = 16'384; // in total
+        std::size_t max_depth = 8; // of ranges within ranges
+    };
+
+    // The limits on this thread: the defaults, unless a ScopedStringifyLimits is in effect
+    auto get_stringify_limits() -> StringifyLimits const&;
+
+    // Applies limits to everything stringified on this thread while in scope, then restores the previous ones
+    class ScopedStringifyLimits {
+        StringifyLimits previous;
+    public:
+        explicit ScopedStringifyLimits( StringifyLimits const& limits );
+        ~ScopedStringifyLimits();
+
+        ScopedStringifyLimits( ScopedStringifyLimits const& ) = delete;
+        auto operator=( ScopedStringifyLimits const& ) -> ScopedStringifyLimits& = delete;
+    };
 }
 
 // This allows any type for which there is a Stringifier specialisation to be usable by std::format.
@@ -54,7 +92,12 @@ template<CatchKit::Stringifiable T>
 struct std::formatter<T> { // NOLINT
     constexpr static auto parse( std::format_parse_context const& ctx ) { return ctx.begin(); }
     auto format(T const& val, auto& ctx) const {
-        return std::format_to( ctx.out(), "{}", CatchKit::Stringifier<T>::stringify(val) );
+        auto const& str = CatchKit::Stringifier<T>::stringify(val);
+        std::string_view text( str );
+        auto max_chars = CatchKit::get_stringify_limits().max_chars;
+        if( max_chars != 0 && text.size() > max_chars )
+            return std::format_to( ctx.out(), "{}...", text.substr( 0, max_chars ) );
+        return std::format_to( ctx.out(), "{}", text );
     }
 };
 
@@ -66,10 +109,188 @@ namespace CatchKit {
     };
 #endif
 
+    namespace Detail {
+        // Numbers that std::to_chars writes exactly as std::format would (so not bool, or any character type)
+        template<typename T>
+        concept ToCharsConvertible =
+            std::is_arithmetic_v<T>
+            && !std::is_same_v<T, bool>
+            && !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t>
+            && !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>
+            && requires( char* p, T value ) { std::to_chars( p, p, value ); }; // excludes extended types, like __int128
+
+        // Big enough for any integer, or the shortest round-trip form of any floating point value
+        using ToCharsBuffer = std::array<char, 64>;
+
+        template<ToCharsConvertible T>
+        auto to_chars( ToCharsBuffer& chars, T value ) -> std::string_view {
+            auto [end, ec] = std::to_chars( chars.data(), chars.data() + chars.size(), value );
+            return { chars.data(), end };
+        }
+
+        // Ranges that stringify writes element by element, so it can stop early
+        template<typename T>
+        concept BoundedRange =
+            std::ranges::input_range<T const>
+            && !std::is_convertible_v<T, std::string> && !std::is_convertible_v<T, std::string_view>
+            && !Stringifiable<T>
+            && std::format_kind<std::remove_cvref_t<T>> != std::range_format::disabled;
+
+        // The types that stringify formats directly, rather than building up a string by some other means
+        template<typename T>
+        concept FormattedInPlace =
+            !std::is_enum_v<T> && !std::is_null_pointer_v<T> && !std::is_pointer_v<T>
+            && ( std::is_convertible_v<T, std::string> || BoundedRange<T> || std::formattable<T, char> );
+
+        // Wraps an output iterator, dropping (but noting) anything written once max_chars have been
+        template<typename OutputIt>
+        class LimitedOutput {
+            OutputIt out;
+            std::size_t chars_left;
+            bool truncated = false;
+
+            void put( char c ) {
+                if( chars_left == 0 ) {
+                    truncated = true;
+                    return;
+                }
+                *out++ = c;
+                --chars_left;
+            }
+
+        public:
+            using difference_type = std::ptrdiff_t;
+
+            // Assignable even when const, as output iterators need to be
+            struct Writer {
+                LimitedOutput* self;
+                void operator=( char c ) const { self->put( c ); } // NOLINT (misc-unconventional-assign-operator)
+            };
+
+            LimitedOutput( OutputIt out, std::size_t max_chars )
+            :   out( std::move( out ) ),
+                chars_left( max_chars == 0 ? std::numeric_limits<std::size_t>::max() : max_chars )
+            {}
+
+            auto operator*() -> Writer { return { this }; }
+            auto operator++() -> LimitedOutput& { return *this; }
+            auto operator++(int) -> LimitedOutput& { return *this; }
+
+            void write( std::string_view text ) {
+                auto n = (std::min)( text.size(), chars_left );
+                out = std::ranges::copy( text.substr( 0, n ), std::move( out ) ).out;
+                chars_left -= n;
+                if( n < text.size() )
+                    truncated = true;
+            }
+            // Once full, anything else that's written is lost, so there's no point producing it
+            [[nodiscard]] auto is_full() const { return chars_left == 0; }
+            [[nodiscard]] auto get_chars_left() const { return chars_left; }
+            void mark_truncated() { truncated = true; }
+
+            // Returns the underlying iterator, having marked where anything was left out
+            [[nodiscard]] auto finish() && -> OutputIt {
+                if( truncated )
+                    out = std::ranges::copy( std::string_view("..."), std::move( out ) ).out;
+                return std::move( out );
+            }
+        };
+
+        template<typename OutputIt, typename T>
+        void write_stringified( LimitedOutput<OutputIt>& out, T const& value, std::size_t depth );
+
+        // Strings within ranges are quoted and escaped, as std::format shows them (a string on its own is just quoted)
+        template<typename OutputIt>
+        void write_string( LimitedOutput<OutputIt>& out, std::string_view text, std::size_t depth ) {
+            if( depth == 0 ) {
+                out.write( "\"" );
+                out.write( text );
+                out.write( "\"" );
+            }
+            else // escaping only ever adds characters, so there's no need to escape more than there's room for
+                out = std::format_to( std::move( out ), "{:?}", text.substr( 0, out.get_chars_left() ) );
+        }
+
+        // Writes elements until they run out, or a limit is reached.
+        // Sets and maps are shown the way std::format shows them
+        template<typename OutputIt, typename R>
+        void write_range( LimitedOutput<OutputIt>& out, R const& range, std::size_t depth ) {
+            constexpr auto kind = std::format_kind<std::remove_cvref_t<R>>;
+            constexpr bool is_set_or_map = kind == std::range_format::set || kind == std::range_format::map;
+            auto const& limits = get_stringify_limits();
+
+            out.write( is_set_or_map ? "{" : "[" );
+            if( limits.max_depth != 0 && depth >= limits.max_depth ) {
+                // (only look inside if that doesn't use anything up)
+                if( !std::ranges::forward_range<R const> || std::ranges::begin( range ) != std::ranges::end( range ) )
+                    out.write( "..." );
+            }
+            else {
+                std::size_t count = 0;
+                for( auto const& element : range ) {
+                    if( out.is_full() ) {
+                        out.mark_truncated();
+                        return;
+                    }
+                    if( count != 0 )
+                        out.write( ", " );
+                    if( limits.max_elements != 0 && count == limits.max_elements ) {
+                        out.write( "..." );
+                        break;
+                    }
+                    if constexpr( kind == std::range_format::map ) {
+                        write_stringified( out, std::get<0>( element ), depth + 1 );
+                        out.write( ": " );
+                        write_stringified( out, std::get<1>( element ), depth + 1 );
+                    }
+                    else
+                        write_stringified( out, element, depth + 1 );
+                    ++count;
+                }
+            }
+            out.write( is_set_or_map ? "}" : "]" );
+        }
+
+        template<typename OutputIt, typename T>
+        void write_stringified( LimitedOutput<OutputIt>& out, T const& value, std::size_t depth ) {
+            if constexpr( ToCharsConvertible<T> ) {
+                ToCharsBuffer chars;
+                out.write( to_chars( chars, value ) );
+            }
+            else if constexpr( std::is_convertible_v<T, std::string> ) {
+                if constexpr( std::is_convertible_v<T, std::string_view> )
+                    write_string( out, std::string_view( value ), depth );
+                else
+                    write_string( out, std::string( value ), depth );
+            }
+            else if constexpr( BoundedRange<T> )
+                write_range( out, value, depth );
+            else if constexpr( std::is_same_v<T, char> ) {
+                if( depth == 0 )
+                    out.write( std::string_view( &value, 1 ) );
+                else
+                    out = std::format_to( std::move( out ), "{:?}", value ); // quoted and escaped, as in std::format
+            }
+            else if constexpr( FormattedInPlace<T> )
+                out = std::format_to( std::move( out ), "{}", value );
+            else
+                out.write( stringify( value ) );
+        }
+    }
+
     // Don't specialise this, specialise Stringifier instead
     template<typename T>
     [[nodiscard]] auto constexpr stringify(T const& value ) {
-        if constexpr( std::is_enum_v<T> )
+        if constexpr( Detail::ToCharsConvertible<T> ) {
+            Detail::ToCharsBuffer chars;
+            return std::string( Detail::to_chars( chars, value ) );
+        }
+        else if constexpr( Detail::FormattedInPlace<T> ) {
+            std::string result;
+            stringify_to( std::back_inserter( result ), value );
+            return result;
+        }
+        else if constexpr( std::is_enum_v<T> )
             return enum_to_string( value );
         else if constexpr( std::is_null_pointer_v<T> )
             return std::string("nullptr");
@@ -83,10 +304,6 @@ namespace CatchKit {
             else
                 return pointer_to_string( value );
         }
-        else if constexpr( std::is_convertible_v<T, std::string> )
-            return std::format("\"{}\"", value);
-        else if constexpr( std::formattable<T, char> )
-            return std::format("{}", value);
 #ifdef FALLBACK_TO_OSTREAM_STRING_CONVERSIONS
         else if constexpr ( Streamable<T> ) {
             std::ostringstream oss;
@@ -102,6 +319,40 @@ namespace CatchKit {
             return std::format( "{}(?)", type_to_string<T>() );
     }
 
+    template<typename T, typename OutputIt>
+    auto stringify_to(OutputIt out, T const& value ) -> OutputIt {
+        if constexpr( Detail::ToCharsConvertible<T> ) {
+            Detail::ToCharsBuffer chars;
+            return std::ranges::copy( Detail::to_chars( chars, value ), out ).out;
+        }
+        else if constexpr( Detail::FormattedInPlace<T> ) {
+            Detail::LimitedOutput limited( std::move( out ), get_stringify_limits().max_chars );
+            Detail::write_stringified( limited, value, 0 );
+            return std::move( limited ).finish();
+        }
+        else
+            return std::ranges::copy( stringify( value ), out ).out;
+    }
+
+    namespace Detail {
+        // Stringifies through the per-thread buffer, so the result is built in one go, at its final size.
+        // That's at most one allocation (or none, if it fits in the small string buffer) however it was formatted.
+        // Not re-entrant: nothing that stringify_to calls comes back through here
+        template<typename T>
+        [[nodiscard]] auto stringify_once( T const& value ) -> std::string {
+            if constexpr( ToCharsConvertible<T> || !FormattedInPlace<T> ) {
+                // Already built at its final size (or by some means that can't use the buffer)
+                return std::string( stringify( value ) );
+            }
+            else {
+                auto& buffer = get_stringify_buffer();
+                buffer.clear();
+                stringify_to( std::back_inserter( buffer ), value );
+                return buffer;
+            }
+        }
+    }
+
 } // namespace CatchKit
 
 #endif // CATCHKIT_STRINGIFY_H
@@ -23,6 +23,14 @@ module;
 #include "catchkit/expr_ref.h"
 #include "catchkit/report_on.h"
 #include "catchkit/stringify.h"
+#include "catchkit/diff.h"
+#include "catchkit/range_compare.h"
+#include "catchkit/stream_compare.h"
+#include "catchkit/regex_cache.h"
+#include "catchkit/string_search.h"
+#include "catchkit/float_compare.h"
+#include "catchkit/parallel.h"
+#include "catchkit/element_match.h"
 #include "catchkit/matchers.h"
 #include "catchkit/internal_matchers.h"
 #include "catchkit/checker.h"
@@ -31,7 +39,14 @@ export module catchkit;
 
 export namespace CatchKit {
     using CatchKit::MatchResult;
+    using CatchKit::DescribedMatchResult;
+    using CatchKit::ElementsMatchResult;
     using CatchKit::stringify;
+    using CatchKit::stringify_to;
+    using CatchKit::get_stringify_buffer;
+    using CatchKit::StringifyLimits;
+    using CatchKit::get_stringify_limits;
+    using CatchKit::ScopedStringifyLimits;
 
     using Detail::Checker;
     using Detail::Asserter;
@@ -42,6 +57,46 @@ export namespace CatchKit {
 export namespace CatchKit::Detail {
     using Detail::Asserter;
     using Detail::TypedVariableCaptureRef;
+    using Detail::passes_fast;
+    using Detail::stringify_once;
+    using Detail::Diff;
+    using Detail::DiffRun;
+    using Detail::diff_sequences;
+    using Detail::render_windowed_diff;
+    using Detail::describe_range_mismatch;
+    using Detail::describe_string_mismatch;
+    using Detail::bytewise_equal;
+    using Detail::first_mismatch;
+    using Detail::UnorderedStrategy;
+    using Detail::choose_unordered_strategy;
+    using Detail::equal_in_any_order;
+    using Detail::contains_in_any_order;
+    using Detail::StreamedRange;
+    using Detail::remaining_elements_of;
+    using Detail::streamed_window_size;
+    using Detail::streamed_context_size;
+    using Detail::max_reported_missing;
+    using Detail::StreamedComparison;
+    using Detail::compare_streamed_in_order;
+    using Detail::compare_streamed_in_any_order;
+    using Detail::contains_streamed_in_any_order;
+    using Detail::CompiledRegex;
+    using Detail::get_compiled_regex;
+    using Detail::regex_matches;
+    using Detail::is_simple_regex;
+    using Detail::equal_ignoring_case;
+    using Detail::find_ignoring_case;
+    using Detail::string_search_implementation;
+    using Detail::ulp_distance;
+    using Detail::count_out_of_tolerance;
+    using Detail::describe_out_of_tolerance;
+    using Detail::Quantifier;
+    using Detail::InParallel;
+    using Detail::max_reported_elements;
+    using Detail::parallel_elements_threshold;
+    using Detail::match_elements;
+    using Detail::parallel_thread_count;
+    using Detail::for_each_chunk_in_parallel;
 }
 export namespace CatchKit::GenericMatchers {}
 export namespace CatchKit::StringMatchers {}
@@ -58,6 +113,13 @@ export namespace CatchKit::Matchers {
     using Matchers::equals;
     using Matchers::has_size;
     using Matchers::is_close_to;
+    using Matchers::all_close_to;
+    using Matchers::all_close_to_rel;
+    using Matchers::all_within_ulp;
+    using Matchers::all_match;
+    using Matchers::any_match;
+    using Matchers::none_match;
+    using Matchers::InParallel;
     using Matchers::is_true;
     using Matchers::is_false;
     using Matchers::matches_predicate;
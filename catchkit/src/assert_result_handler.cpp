@@ -22,7 +22,7 @@ namespace CatchKit::Detail {
             return ResultDetailNeeded::No;
         return ResultDetailNeeded::Yes;
     }
-    void AssertResultHandler::on_assertion_result_detail( ExpressionInfo const& expression_info, std::string_view message ) {
+    void AssertResultHandler::on_assertion_result_detail( ExpressionInfo&& expression_info, std::string_view message ) {
         // !TBD When we can use stacktrace do something like this:
         // https://godbolt.org/z/jM4TnaMEW
 
@@ -9,15 +9,17 @@ namespace {
     CatchKit::Detail::AssertResultHandler default_assertion_handler; // NOSONAR NOLINT (misc-typo)
 }
 
-constinit CatchKit::Checker catch23_checker{ &default_assertion_handler }; // NOSONAR NOLINT (misc-typo)
+constinit thread_local CatchKit::Checker catch23_checker{ &default_assertion_handler }; // NOSONAR NOLINT (misc-typo)
 
 namespace CatchKit::Detail {
 
     auto Checker::check(AssertionContext const& context, InvertResult invert_result) -> Asserter {
+        flush_fast_passes();
         result_handler->on_assertion_start(ResultDisposition::Continue, context);
         return Asserter( *this, invert_result );
     }
     auto Checker::require(AssertionContext const& context, InvertResult invert_result) -> Asserter {
+        flush_fast_passes();
         result_handler->on_assertion_start(ResultDisposition::Abort, context);
         return Asserter( *this, invert_result );
     }
@@ -29,9 +31,9 @@ namespace CatchKit::Detail {
     Asserter::~Asserter() noexcept(false) {
         if( expression_info ) {
             if( checker.message_stream )
-                checker.result_handler->on_assertion_result_detail( *expression_info, checker.message_stream->str() );
+                checker.result_handler->on_assertion_result_detail( std::move( *expression_info ), checker.message_stream->view() );
             else
-                checker.result_handler->on_assertion_result_detail( *expression_info, {} );
+                checker.result_handler->on_assertion_result_detail( std::move( *expression_info ), {} );
         }
 
         checker.result_handler->on_assertion_end(); // This may throw to cancel the test
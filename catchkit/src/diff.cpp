@@ -0,0 +1,316 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/diff.h"
+
+#include <algorithm>
+#include <format>
+#include <tuple>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        using Index = std::ptrdiff_t;
+        using enum DiffRun::Type;
+
+        class Differ {
+            ElementComparer equal;
+            Index max_d;
+            Index offset;
+            // The furthest x reached on each diagonal (k = x - y), forwards from the start and backwards from the end
+            std::vector<Index> forward;
+            std::vector<Index> backward;
+            std::vector<DiffRun>& runs;
+
+            struct Snake {
+                Index x, y; // start
+                Index u, v; // end
+            };
+
+            auto fwd( Index k ) -> Index& { return forward[static_cast<std::size_t>( k + offset )]; }
+            auto bwd( Index k ) -> Index& { return backward[static_cast<std::size_t>( k + offset )]; }
+
+            // Finds the middle snake of the shortest edit script, unless that needs more than max_d steps from each end
+            auto find_middle_snake( Index a0, Index n, Index b0, Index m, Snake& snake ) -> bool {
+                Index const delta = n - m;
+                bool const odd = ( delta & 1 ) != 0;
+                Index const limit = (std::min)( ( n + m + 1 ) / 2, max_d );
+
+                fwd( 1 ) = 0;
+                bwd( 1 ) = 0;
+                for( Index d = 0; d <= limit; ++d ) {
+                    for( Index k = -d; k <= d; k += 2 ) {
+                        Index x = ( k == -d || ( k != d && fwd( k - 1 ) < fwd( k + 1 ) ) ) ? fwd( k + 1 ) : fwd( k - 1 ) + 1;
+                        Index y = x - k;
+                        Index const x0 = x;
+                        Index const y0 = y;
+                        while( x < n && y < m && equal( static_cast<std::size_t>( a0 + x ), static_cast<std::size_t>( b0 + y ) ) ) {
+                            ++x;
+                            ++y;
+                        }
+                        fwd( k ) = x;
+                        if( odd && delta - k >= -( d - 1 ) && delta - k <= d - 1 && x + bwd( delta - k ) >= n ) {
+                            snake = { x0, y0, x, y };
+                            return true;
+                        }
+                    }
+                    for( Index k = -d; k <= d; k += 2 ) {
+                        Index x = ( k == -d || ( k != d && bwd( k - 1 ) < bwd( k + 1 ) ) ) ? bwd( k + 1 ) : bwd( k - 1 ) + 1;
+                        Index y = x - k;
+                        Index const x0 = x;
+                        Index const y0 = y;
+                        while( x < n && y < m && equal( static_cast<std::size_t>( a0 + n - x - 1 ), static_cast<std::size_t>( b0 + m - y - 1 ) ) ) {
+                            ++x;
+                            ++y;
+                        }
+                        bwd( k ) = x;
+                        if( !odd && delta - k >= -d && delta - k <= d && x + fwd( delta - k ) >= n ) {
+                            snake = { n - x, m - y, n - x0, m - y0 };
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+        public:
+            Differ( ElementComparer equal, std::size_t max_edits, std::vector<DiffRun>& runs )
+            :   equal( equal ),
+                max_d( static_cast<Index>( max_edits / 2 + 1 ) ),
+                offset( max_d + 1 ),
+                forward( static_cast<std::size_t>( 2 * max_d + 3 ) ),
+                backward( static_cast<std::size_t>( 2 * max_d + 3 ) ),
+                runs( runs )
+            {}
+
+            void add_run( DiffRun::Type type, Index expected_index, Index actual_index, Index length ) {
+                if( length == 0 )
+                    return;
+                if( !runs.empty() && runs.back().type == type )
+                    runs.back().length += static_cast<std::size_t>( length );
+                else
+                    runs.push_back( { type, static_cast<std::size_t>( expected_index ), static_cast<std::size_t>( actual_index ), static_cast<std::size_t>( length ) } );
+            }
+
+            // Adds the runs that turn expected[a0, a0+n) into actual[b0, b0+m), or returns false if that's too many edits.
+            // Each half of a middle snake needs fewer edits than the whole, so only the outermost call can fail.
+            // The first prefix elements may already be known to be the same
+            auto compare( Index a0, Index n, Index b0, Index m, Index prefix = 0 ) -> bool {
+                while( prefix < n && prefix < m && equal( static_cast<std::size_t>( a0 + prefix ), static_cast<std::size_t>( b0 + prefix ) ) )
+                    ++prefix;
+                add_run( Same, a0, b0, prefix );
+                a0 += prefix;
+                b0 += prefix;
+                n -= prefix;
+                m -= prefix;
+
+                Index suffix = 0;
+                while( suffix < n && suffix < m && equal( static_cast<std::size_t>( a0 + n - suffix - 1 ), static_cast<std::size_t>( b0 + m - suffix - 1 ) ) )
+                    ++suffix;
+                n -= suffix;
+                m -= suffix;
+
+                if( n == 0 )
+                    add_run( Added, a0, b0, m );
+                else if( m == 0 )
+                    add_run( Removed, a0, b0, n );
+                else {
+                    Snake snake{};
+                    if( !find_middle_snake( a0, n, b0, m, snake ) )
+                        return false;
+                    compare( a0, snake.x, b0, snake.y );
+                    add_run( Same, a0 + snake.x, b0 + snake.y, snake.u - snake.x );
+                    compare( a0 + snake.u, n - snake.u, b0 + snake.v, m - snake.v );
+                }
+                add_run( Same, a0 + n, b0 + m, suffix );
+                return true;
+            }
+        };
+
+        // How much of a diff gets rendered
+        constexpr std::size_t context_lines = 3;
+        constexpr std::size_t context_chars = 20;
+        constexpr std::size_t max_hunks = 5;
+        constexpr std::size_t max_changed_lines = 20; // of each change
+        constexpr std::size_t max_changed_chars = 80;
+        constexpr std::size_t max_inline_changes = 10;
+        constexpr std::size_t min_unchanged_chars = 3; // between inline changes, to show them separately
+
+        auto describe_first_difference( Diff const& diff ) -> std::string {
+            if( diff.complete )
+                return std::format( "first difference at index {}", diff.first_difference );
+            return std::format( "first difference at index {} (too many differences to find them all)", diff.first_difference );
+        }
+    }
+
+    auto diff_sequences( std::size_t expected_size, std::size_t actual_size, ElementComparer equal, std::size_t max_edits, std::size_t common_prefix ) -> Diff {
+        Diff diff{ {}, 0, true };
+        Differ differ( equal, max_edits, diff.runs );
+        auto const n = static_cast<Index>( expected_size );
+        auto const m = static_cast<Index>( actual_size );
+        if( !differ.compare( 0, n, 0, m, static_cast<Index>( common_prefix ) ) ) {
+            // Too different to work out the details, so just say where the differences start and end
+            diff.complete = false;
+            auto prefix = diff.runs.empty() ? Index{} : static_cast<Index>( diff.runs.front().length );
+            Index suffix = 0;
+            while( suffix < n - prefix && suffix < m - prefix && equal( static_cast<std::size_t>( n - suffix - 1 ), static_cast<std::size_t>( m - suffix - 1 ) ) )
+                ++suffix;
+            diff.runs.clear();
+            differ.add_run( Same, 0, 0, prefix );
+            differ.add_run( Removed, prefix, prefix, n - prefix - suffix );
+            differ.add_run( Added, prefix, prefix, m - prefix - suffix );
+            differ.add_run( Same, n - suffix, m - suffix, suffix );
+        }
+        auto first_change = std::ranges::find_if( diff.runs, []( DiffRun const& run ) { return run.type != Same; } );
+        diff.first_difference = first_change == diff.runs.end() ? expected_size : first_change->expected_index;
+        return diff;
+    }
+
+    auto render_diff_lines( Diff const& diff, ElementRenderer const& render_element ) -> std::string {
+        std::string out = describe_first_difference( diff );
+        std::size_t hunks = 0;
+        bool in_hunk = false;
+
+        auto start_hunk = [&]( std::size_t expected_index, std::size_t actual_index ) -> bool {
+            if( hunks == max_hunks ) {
+                out += "\n...";
+                return false;
+            }
+            ++hunks;
+            in_hunk = true;
+            out += std::format( "\n@@ expected[{}], actual[{}] @@", expected_index, actual_index );
+            return true;
+        };
+        auto add_same_lines = [&]( DiffRun const& run, std::size_t from, std::size_t count ) {
+            for( std::size_t i = from; i < from + count; ++i )
+                out += std::format( "\n    {}", render_element( true, run.expected_index + i ) );
+        };
+
+        for( auto it = diff.runs.begin(); it != diff.runs.end(); ++it ) {
+            auto const& run = *it;
+            if( run.type == Same ) {
+                // Carry on the hunk before (if any) with some context, then start the next one with some more
+                auto leading = it == diff.runs.begin() ? 0 : (std::min)( context_lines, run.length );
+                auto trailing = it + 1 == diff.runs.end() ? 0 : (std::min)( context_lines, run.length );
+                if( leading + trailing >= run.length ) {
+                    if( !in_hunk && !start_hunk( run.expected_index, run.actual_index ) )
+                        break;
+                    add_same_lines( run, 0, run.length );
+                }
+                else {
+                    add_same_lines( run, 0, leading );
+                    in_hunk = false;
+                    if( trailing != 0 ) {
+                        auto from = run.length - trailing;
+                        if( !start_hunk( run.expected_index + from, run.actual_index + from ) )
+                            break;
+                        add_same_lines( run, from, trailing );
+                    }
+                }
+            }
+            else {
+                if( !in_hunk && !start_hunk( run.expected_index, run.actual_index ) )
+                    break;
+                bool const from_expected = run.type == Removed;
+                auto index = from_expected ? run.expected_index : run.actual_index;
+                auto shown = (std::min)( run.length, max_changed_lines );
+                for( std::size_t i = 0; i < shown; ++i )
+                    out += std::format( "\n  {} {}", from_expected ? '-' : '+', render_element( from_expected, index + i ) );
+                if( shown < run.length )
+                    out += std::format( "\n  {} ... ({} more)", from_expected ? '-' : '+', run.length - shown );
+            }
+        }
+        return out;
+    }
+
+    auto render_windowed_diff( std::size_t offset, std::size_t expected_size, std::size_t actual_size, ElementComparer equal, ElementRenderer const& render_element, bool truncated ) -> std::string {
+        auto diff = diff_sequences( expected_size, actual_size, equal );
+        if( truncated ) {
+            auto first_change = std::ranges::find_if( diff.runs, []( DiffRun const& run ) { return run.type != Same; } );
+            auto after_last_same = std::find_if( diff.runs.rbegin(), diff.runs.rend(), []( DiffRun const& run ) { return run.type == Same; } ).base();
+            if( after_last_same - first_change > 1 )
+                diff.runs.erase( after_last_same, diff.runs.end() );
+        }
+        for( auto& run : diff.runs ) {
+            run.expected_index += offset;
+            run.actual_index += offset;
+        }
+        diff.first_difference += offset;
+
+        auto out = render_diff_lines( diff, [&]( bool from_expected, std::size_t index ) {
+            return render_element( from_expected, index - offset );
+        } );
+        if( truncated )
+            out += "\n(the ranges were only compared this far)";
+        return out;
+    }
+
+    auto render_diff_inline( Diff const& diff, std::string_view expected, std::string_view actual ) -> std::string {
+        std::string out = describe_first_difference( diff );
+        out += "\n\"";
+
+        // Changes separated by only a character or two read better as one
+        std::string removed;
+        std::string added;
+        std::size_t changes = 0;
+        auto add_change = [&]() -> bool {
+            if( removed.empty() && added.empty() )
+                return true;
+            if( changes++ == max_inline_changes ) {
+                out += "...";
+                return false;
+            }
+            for( auto const& [text, open, close] : { std::tuple{ &removed, "[-", "-]" }, std::tuple{ &added, "{+", "+}" } } ) {
+                if( text->size() > max_changed_chars )
+                    std::format_to( std::back_inserter( out ), "{}{}...{}", open, std::string_view( *text ).substr( 0, max_changed_chars ), close );
+                else if( !text->empty() )
+                    std::format_to( std::back_inserter( out ), "{}{}{}", open, *text, close );
+                text->clear();
+            }
+            return true;
+        };
+
+        bool stopped = false;
+        for( auto it = diff.runs.begin(); it != diff.runs.end() && !stopped; ++it ) {
+            auto const& run = *it;
+            if( run.type == Removed )
+                removed += expected.substr( run.expected_index, run.length );
+            else if( run.type == Added )
+                added += actual.substr( run.actual_index, run.length );
+            else {
+                auto text = expected.substr( run.expected_index, run.length );
+                bool const first = it == diff.runs.begin();
+                bool const last = it + 1 == diff.runs.end();
+                if( !first && !last && text.size() < min_unchanged_chars ) {
+                    removed += text;
+                    added += text;
+                    continue;
+                }
+                if( !add_change() ) {
+                    stopped = true;
+                    break;
+                }
+                if( first && text.size() > context_chars )
+                    std::format_to( std::back_inserter( out ), "...{}", text.substr( text.size() - context_chars ) );
+                else if( last && text.size() > context_chars )
+                    std::format_to( std::back_inserter( out ), "{}...", text.substr( 0, context_chars ) );
+                else if( !first && !last && text.size() > 2 * context_chars )
+                    std::format_to( std::back_inserter( out ), "{}...{}", text.substr( 0, context_chars ), text.substr( text.size() - context_chars ) );
+                else
+                    out += text;
+            }
+        }
+        if( !stopped && add_change() )
+            out += '"';
+        return out;
+    }
+
+    auto split_lines( std::string_view text ) -> std::vector<std::string_view> {
+        std::vector<std::string_view> lines;
+        for( auto const line : std::views::split( text, '\n' ) )
+            lines.emplace_back( line.begin(), line.end() );
+        return lines;
+    }
+
+} // namespace CatchKit::Detail
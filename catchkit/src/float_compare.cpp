@@ -0,0 +1,54 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/float_compare.h"
+#include "catchkit/internal_platform.h"
+
+namespace CatchKit::Detail {
+
+    namespace {
+        // Whole blocks of a fixed size are vectorised even where the compiler won't add a loop for
+        // the remainder (as GCC won't, at -O2), so only what's left after the last block is scalar
+        template<typename T, typename Tolerance>
+        CATCHKIT_ALWAYS_INLINE auto count_in_blocks( T const* expected, T const* actual, std::size_t size, Tolerance tolerance ) -> std::size_t {
+            constexpr std::size_t block_size = 64;
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for( ; i + block_size <= size; i += block_size ) {
+                unsigned block_count = 0;
+                for( std::size_t j = i; j < i + block_size; ++j )
+                    block_count += static_cast<unsigned>( !tolerance.within( expected[j], actual[j] ) );
+                count += block_count;
+            }
+            for( ; i < size; ++i )
+                count += static_cast<std::size_t>( !tolerance.within( expected[i], actual[i] ) );
+            return count;
+        }
+
+#ifdef CATCHKIT_ARCH_X86_64
+        template<typename T, typename Tolerance>
+        CATCHKIT_TARGET_AVX2 auto count_in_blocks_avx2( T const* expected, T const* actual, std::size_t size, Tolerance tolerance ) -> std::size_t {
+            return count_in_blocks( expected, actual, size, tolerance );
+        }
+#endif
+    }
+
+    template<FloatOrDouble T, typename Tolerance>
+    auto count_out_of_tolerance( std::span<T const> expected, std::span<T const> actual, Tolerance tolerance ) -> std::size_t {
+#ifdef CATCHKIT_ARCH_X86_64
+        static bool const use_avx2 = cpu_has_avx2(); // NOSONAR NOLINT (misc-typo)
+        if( use_avx2 )
+            return count_in_blocks_avx2( expected.data(), actual.data(), expected.size(), tolerance );
+#endif
+        return count_in_blocks( expected.data(), actual.data(), expected.size(), tolerance );
+    }
+
+    template auto count_out_of_tolerance( std::span<float const>, std::span<float const>, AbsoluteTolerance ) -> std::size_t;
+    template auto count_out_of_tolerance( std::span<double const>, std::span<double const>, AbsoluteTolerance ) -> std::size_t;
+    template auto count_out_of_tolerance( std::span<float const>, std::span<float const>, RelativeTolerance ) -> std::size_t;
+    template auto count_out_of_tolerance( std::span<double const>, std::span<double const>, RelativeTolerance ) -> std::size_t;
+    template auto count_out_of_tolerance( std::span<float const>, std::span<float const>, UlpTolerance ) -> std::size_t;
+    template auto count_out_of_tolerance( std::span<double const>, std::span<double const>, UlpTolerance ) -> std::size_t;
+
+} // namespace CatchKit::Detail
@@ -3,3 +3,28 @@
 //
 
 #include "catchkit/internal_platform.h"
+
+#if defined(CATCHKIT_ARCH_X86_64) && defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace CatchKit::Detail {
+
+    auto cpu_has_avx2() -> bool {
+#if defined(CATCHKIT_ARCH_X86_64) && defined(_MSC_VER)
+        static bool const has_avx2 = [] { // NOSONAR NOLINT (misc-typo)
+            int info[4];
+            __cpuid( info, 1 );
+            bool const os_saves_avx = ( info[2] & ( 1 << 27 ) ) != 0 && ( _xgetbv( 0 ) & 0x6 ) == 0x6;
+            __cpuidex( info, 7, 0 );
+            return os_saves_avx && ( info[1] & ( 1 << 5 ) ) != 0;
+        }();
+        return has_avx2;
+#elif defined(CATCHKIT_ARCH_X86_64)
+        return __builtin_cpu_supports( "avx2" );
+#else
+        return false;
+#endif
+    }
+
+} // namespace CatchKit::Detail
@@ -3,9 +3,9 @@
 //
 
 #include "catchkit/matchers.h"
+#include "catchkit/string_search.h"
 
 #include <algorithm>
-#include <regex>
 
 namespace CatchKit {
 
@@ -24,23 +24,23 @@ namespace CatchKit {
             return str.contains(substr);
         }
         bool CaseInsensitive::equal(std::string_view str1, std::string_view str2) {
-            return std::ranges::equal(str1, str2,
-                [](char a, char b) {
-                    return std::tolower(a) == std::tolower(b);
-                });
+            return Detail::equal_ignoring_case(str1, str2);
         }
         bool CaseInsensitive::find(std::string_view str, std::string_view substr) {
-            return !std::ranges::search(str, substr,
-                [](char a, char b) {
-                    return std::tolower(a) == std::tolower(b);
-                }).empty();
+            return Detail::find_ignoring_case(str, substr) != std::string_view::npos;
         }
 
         bool CaseSensitive::matches_regex(std::string const& str, std::string const& regex_str) {
-            return std::regex_match(str, std::regex(regex_str));
+            return Detail::regex_matches(*compile_regex(regex_str), str);
         }
         bool CaseInsensitive::matches_regex(std::string const& str, std::string const& regex_str) {
-            return std::regex_match(str, std::regex(regex_str, std::regex::icase));
+            return Detail::regex_matches(*compile_regex(regex_str), str);
+        }
+        auto CaseSensitive::compile_regex(std::string const& regex_str) -> std::shared_ptr<Detail::CompiledRegex const> {
+            return Detail::get_compiled_regex(regex_str, false);
+        }
+        auto CaseInsensitive::compile_regex(std::string const& regex_str) -> std::shared_ptr<Detail::CompiledRegex const> {
+            return Detail::get_compiled_regex(regex_str, true);
         }
 
     } // namespace StringMatchers
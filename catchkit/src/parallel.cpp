@@ -0,0 +1,162 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CatchKit::Detail {
+
+    namespace {
+
+        // The state of one call to for_each_chunk_in_parallel. It's shared with the helper threads, which may only
+        // get to it after the call has finished - in which case they leave it alone
+        struct ParallelJob {
+            std::function<bool(std::size_t)> const& do_chunk;
+            std::size_t chunk_count;
+            std::atomic<std::size_t> next_chunk = 0;
+            std::atomic<bool> stop = false;
+
+            std::mutex mutex;
+            std::condition_variable helpers_finished;
+            std::size_t helpers = 0;
+            bool finished = false;
+            std::exception_ptr first_exception;
+
+            void work() {
+                while( !stop.load( std::memory_order_relaxed ) ) {
+                    auto const chunk = next_chunk.fetch_add( 1, std::memory_order_relaxed );
+                    if( chunk >= chunk_count )
+                        return;
+                    try {
+                        if( do_chunk( chunk ) )
+                            stop = true;
+                    }
+                    catch(...) {
+                        std::scoped_lock lock( mutex );
+                        if( !first_exception )
+                            first_exception = std::current_exception();
+                        stop = true;
+                    }
+                }
+            }
+            void help() {
+                {
+                    std::scoped_lock lock( mutex );
+                    if( finished )
+                        return;
+                    ++helpers;
+                }
+                work();
+                std::scoped_lock lock( mutex );
+                if( --helpers == 0 )
+                    helpers_finished.notify_all();
+            }
+            // Stops any more helpers joining, and waits for those that did to finish
+            void finish() {
+                std::unique_lock lock( mutex );
+                finished = true;
+                helpers_finished.wait( lock, [this]{ return helpers == 0; } );
+            }
+        };
+
+        // One set of helper threads, started the first time they're needed, is shared by every caller.
+        // So when tests are run across threads, each one matching in parallel doesn't start its own set
+        class HelperPool {
+            std::mutex mutex;
+            std::condition_variable has_jobs;
+            std::deque<std::shared_ptr<ParallelJob>> jobs;
+            bool stopping = false;
+            std::vector<std::jthread> threads; // last, so they're joined before the rest is destroyed
+
+            void run() {
+                while( true ) {
+                    std::shared_ptr<ParallelJob> job;
+                    {
+                        std::unique_lock lock( mutex );
+                        has_jobs.wait( lock, [this]{ return stopping || !jobs.empty(); } );
+                        if( stopping )
+                            return;
+                        job = std::move( jobs.front() );
+                        jobs.pop_front();
+                    }
+                    job->help();
+                }
+            }
+
+        public:
+            explicit HelperPool( std::size_t thread_count ) {
+                threads.reserve( thread_count );
+                for( std::size_t i = 0; i < thread_count; ++i )
+                    threads.emplace_back( [this]{ run(); } );
+            }
+            ~HelperPool() {
+                {
+                    std::scoped_lock lock( mutex );
+                    stopping = true;
+                }
+                has_jobs.notify_all();
+            }
+            HelperPool( HelperPool const& ) = delete;
+            auto operator=( HelperPool const& ) -> HelperPool& = delete;
+
+            // Asks for up to helper_count threads to help with the job, as they come free
+            void post( std::shared_ptr<ParallelJob> const& job, std::size_t helper_count ) {
+                {
+                    std::scoped_lock lock( mutex );
+                    for( std::size_t i = 0; i < helper_count; ++i )
+                        jobs.push_back( job );
+                }
+                has_jobs.notify_all();
+            }
+            // Takes back any requests for the job that no thread has picked up yet
+            void withdraw( std::shared_ptr<ParallelJob> const& job ) {
+                std::scoped_lock lock( mutex );
+                std::erase( jobs, job );
+            }
+        };
+
+        auto get_helper_pool() -> HelperPool& {
+            static HelperPool pool( parallel_thread_count() - 1 );
+            return pool;
+        }
+
+    } // namespace
+
+    auto parallel_thread_count() -> std::size_t {
+        static std::size_t const thread_count = (std::max)( std::thread::hardware_concurrency(), 1u ); // NOSONAR NOLINT (misc-typo)
+        return thread_count;
+    }
+
+    auto for_each_chunk_in_parallel( std::size_t chunk_count, std::function<bool(std::size_t)> const& do_chunk ) -> std::size_t {
+        if( chunk_count == 0 )
+            return 0;
+        auto job = std::make_shared<ParallelJob>( do_chunk, chunk_count );
+
+        auto const helper_count = (std::min)( parallel_thread_count(), chunk_count ) - 1;
+        if( helper_count > 0 ) {
+            auto& pool = get_helper_pool();
+            pool.post( job, helper_count );
+            job->work();
+            pool.withdraw( job );
+            job->finish();
+        }
+        else {
+            job->work();
+        }
+
+        if( job->first_exception )
+            std::rethrow_exception( job->first_exception );
+        return (std::min)( job->next_chunk.load(), chunk_count );
+    }
+
+} // namespace CatchKit::Detail
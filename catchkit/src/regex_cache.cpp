@@ -0,0 +1,174 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/regex_cache.h"
+#include "catchkit/matchers.h"
+
+#include <cctype>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <unordered_map>
+#include <utility>
+
+namespace CatchKit::Detail {
+
+    namespace {
+        struct SimplePattern {
+            enum class Kind { Equals, StartsWith, EndsWith, Contains };
+            Kind kind;
+            std::string text;
+            bool has_wildcard; // . doesn't match line breaks, so those strings still go to std::regex
+        };
+
+        auto is_metacharacter( char c ) -> bool {
+            return std::string_view( "\\^$.|?*+()[]{}" ).contains( c );
+        }
+
+        // Returns the text to compare, or search for, if the pattern is only text
+        // - perhaps escaped, and perhaps with .* (and ^ or $) at either end
+        auto parse_simple_pattern( std::string_view pattern ) -> std::optional<SimplePattern> {
+            // regex_match anchors at both ends anyway
+            if( pattern.starts_with( '^' ) )
+                pattern.remove_prefix( 1 );
+            bool const any_prefix = pattern.starts_with( ".*" );
+            if( any_prefix )
+                pattern.remove_prefix( 2 );
+
+            std::string text;
+            bool any_suffix = false;
+            for( std::size_t i = 0; i < pattern.size(); ++i ) {
+                auto const rest = pattern.substr( i );
+                if( rest == ".*" || rest == ".*$" ) {
+                    any_suffix = true;
+                    break;
+                }
+                if( rest == "$" )
+                    break;
+                if( pattern[i] == '\\' ) {
+                    // Escaped punctuation is just that character, but escaped letters and digits are classes, back-references, etc
+                    if( rest.size() == 1 || std::isalnum( static_cast<unsigned char>( rest[1] ) ) )
+                        return {};
+                    text += pattern[++i];
+                }
+                else if( is_metacharacter( pattern[i] ) )
+                    return {};
+                else
+                    text += pattern[i];
+            }
+
+            using enum SimplePattern::Kind;
+            auto kind = any_prefix
+                ? ( any_suffix ? Contains : EndsWith )
+                : ( any_suffix ? StartsWith : Equals );
+            return SimplePattern{ kind, std::move( text ), any_prefix || any_suffix };
+        }
+    }
+
+    struct CompiledRegex {
+        std::string pattern;
+        bool ignore_case;
+        std::optional<SimplePattern> simple;
+
+        // Simple patterns only need std::regex for strings with line breaks, so it's compiled on first use
+        mutable std::once_flag compile_once;
+        mutable std::optional<std::regex> regex;
+
+        CompiledRegex( std::string const& pattern, bool ignore_case )
+        :   pattern( pattern ),
+            ignore_case( ignore_case ),
+            simple( parse_simple_pattern( pattern ) )
+        {
+            if( !simple )
+                get_regex();
+        }
+
+        auto get_regex() const -> std::regex const& {
+            std::call_once( compile_once, [this] {
+                regex.emplace( pattern, ignore_case ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript );
+            } );
+            return *regex;
+        }
+        auto equal( std::string_view str1, std::string_view str2 ) const -> bool {
+            return ignore_case
+                ? StringMatchers::CaseInsensitive::equal( str1, str2 )
+                : StringMatchers::CaseSensitive::equal( str1, str2 );
+        }
+        auto find( std::string_view str, std::string_view substr ) const -> bool {
+            return ignore_case
+                ? StringMatchers::CaseInsensitive::find( str, substr )
+                : StringMatchers::CaseSensitive::find( str, substr );
+        }
+    };
+
+    namespace {
+        class RegexCache {
+            using Entry = std::pair<std::string, std::shared_ptr<CompiledRegex const>>;
+
+            std::mutex mutex;
+            std::list<Entry> entries; // most recently used first
+            std::unordered_map<std::string_view, std::list<Entry>::iterator> index; // keys refer to the strings in entries
+
+            auto find( std::string_view key ) -> std::shared_ptr<CompiledRegex const> {
+                auto it = index.find( key );
+                if( it == index.end() )
+                    return {};
+                entries.splice( entries.begin(), entries, it->second );
+                return entries.front().second;
+            }
+
+        public:
+            auto get( std::string const& pattern, bool ignore_case ) -> std::shared_ptr<CompiledRegex const> {
+                std::string key = ( ignore_case ? "i:" : "s:" ) + pattern;
+                {
+                    std::scoped_lock lock( mutex );
+                    if( auto compiled = find( key ) )
+                        return compiled;
+                }
+                // Compiled without the lock held, as it may take a while (or throw)
+                auto compiled = std::make_shared<CompiledRegex const>( pattern, ignore_case );
+
+                std::scoped_lock lock( mutex );
+                if( auto already_compiled = find( key ) )
+                    return already_compiled;
+                entries.emplace_front( std::move( key ), compiled );
+                index.emplace( entries.front().first, entries.begin() );
+                if( entries.size() > regex_cache_capacity ) {
+                    index.erase( entries.back().first );
+                    entries.pop_back();
+                }
+                return compiled;
+            }
+        };
+    }
+
+    auto get_compiled_regex( std::string const& pattern, bool ignore_case ) -> std::shared_ptr<CompiledRegex const> {
+        static RegexCache cache; // NOSONAR NOLINT (misc-typo)
+        return cache.get( pattern, ignore_case );
+    }
+
+    auto regex_matches( CompiledRegex const& regex, std::string_view str ) -> bool {
+        if( regex.simple && !( regex.simple->has_wildcard && str.find_first_of( "\r\n" ) != std::string_view::npos ) ) {
+            auto const& text = regex.simple->text;
+            switch( regex.simple->kind ) {
+                using enum SimplePattern::Kind;
+                case Equals:
+                    return regex.equal( str, text );
+                case StartsWith:
+                    return str.size() >= text.size() && regex.equal( str.substr( 0, text.size() ), text );
+                case EndsWith:
+                    return str.size() >= text.size() && regex.equal( str.substr( str.size() - text.size() ), text );
+                case Contains:
+                    return regex.find( str, text );
+            }
+        }
+        return std::regex_match( str.begin(), str.end(), regex.get_regex() );
+    }
+
+    auto is_simple_regex( CompiledRegex const& regex ) -> bool {
+        return regex.simple.has_value();
+    }
+
+} // namespace CatchKit::Detail
@@ -0,0 +1,199 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/string_search.h"
+#include "catchkit/internal_platform.h"
+
+#include <array>
+#include <bit>
+#include <string_view>
+
+#ifdef CATCHKIT_ARCH_X86_64
+#  include <immintrin.h>
+#endif
+
+namespace CatchKit::Detail {
+
+    namespace {
+        constexpr auto fold_table = [] {
+            std::array<unsigned char, 256> table{};
+            for( std::size_t c = 0; c < table.size(); ++c )
+                table[c] = static_cast<unsigned char>( c >= 'A' && c <= 'Z' ? c + ( 'a' - 'A' ) : c );
+            return table;
+        }();
+
+        auto fold( char c ) -> unsigned char {
+            return fold_table[static_cast<unsigned char>( c )];
+        }
+
+        // Candidates for find are where both the first and last characters of substr match (allowing for case),
+        // so only those are compared in full, with the same implementation's equal
+        template<auto equal>
+        auto verify_candidates( std::string_view str, std::string_view substr, std::size_t start, unsigned mask ) -> std::size_t {
+            for( ; mask != 0; mask &= mask - 1 ) {
+                auto const pos = start + static_cast<std::size_t>( std::countr_zero( mask ) );
+                if( equal( str.substr( pos, substr.size() ), substr ) )
+                    return pos;
+            }
+            return std::string_view::npos;
+        }
+
+        // What's left after the last whole block
+        auto find_tail( std::string_view str, std::string_view substr, std::size_t start ) -> std::size_t {
+            auto pos = find_ignoring_case_scalar( str.substr( start ), substr );
+            return pos == std::string_view::npos ? pos : start + pos;
+        }
+
+#ifdef CATCHKIT_ARCH_X86_64
+
+        // SSE2 is always there on x86-64
+        auto fold_block( __m128i block ) -> __m128i {
+            auto const is_upper = _mm_and_si128(
+                _mm_cmpgt_epi8( block, _mm_set1_epi8( 'A' - 1 ) ),
+                _mm_cmplt_epi8( block, _mm_set1_epi8( 'Z' + 1 ) ) );
+            return _mm_or_si128( block, _mm_and_si128( is_upper, _mm_set1_epi8( 'a' - 'A' ) ) );
+        }
+        auto load_block( char const* data ) -> __m128i {
+            return _mm_loadu_si128( reinterpret_cast<__m128i const*>( data ) );
+        }
+
+        auto equal_ignoring_case_sse2( std::string_view str1, std::string_view str2 ) -> bool {
+            if( str1.size() != str2.size() )
+                return false;
+            std::size_t i = 0;
+            for( ; i + 16 <= str1.size(); i += 16 ) {
+                auto const matches = _mm_cmpeq_epi8( fold_block( load_block( str1.data() + i ) ), fold_block( load_block( str2.data() + i ) ) );
+                if( _mm_movemask_epi8( matches ) != 0xffff )
+                    return false;
+            }
+            return equal_ignoring_case_scalar( str1.substr( i ), str2.substr( i ) );
+        }
+
+        auto find_ignoring_case_sse2( std::string_view str, std::string_view substr ) -> std::size_t {
+            if( substr.empty() )
+                return 0;
+            if( substr.size() > str.size() )
+                return std::string_view::npos;
+
+            auto const first = _mm_set1_epi8( static_cast<char>( fold( substr.front() ) ) );
+            auto const last = _mm_set1_epi8( static_cast<char>( fold( substr.back() ) ) );
+            auto const candidates_end = str.size() - substr.size() + 1;
+            std::size_t i = 0;
+            for( ; i + 16 <= candidates_end; i += 16 ) {
+                auto const matches = _mm_and_si128(
+                    _mm_cmpeq_epi8( fold_block( load_block( str.data() + i ) ), first ),
+                    _mm_cmpeq_epi8( fold_block( load_block( str.data() + i + substr.size() - 1 ) ), last ) );
+                auto const mask = static_cast<unsigned>( _mm_movemask_epi8( matches ) );
+                if( mask != 0 ) {
+                    if( auto pos = verify_candidates<equal_ignoring_case_sse2>( str, substr, i, mask ); pos != std::string_view::npos )
+                        return pos;
+                }
+            }
+            return find_tail( str, substr, i );
+        }
+
+        // AVX2 needs to be checked for, so these are compiled for it separately
+        CATCHKIT_TARGET_AVX2 auto fold_block_avx2( __m256i block ) -> __m256i {
+            auto const is_upper = _mm256_and_si256(
+                _mm256_cmpgt_epi8( block, _mm256_set1_epi8( 'A' - 1 ) ),
+                _mm256_cmpgt_epi8( _mm256_set1_epi8( 'Z' + 1 ), block ) );
+            return _mm256_or_si256( block, _mm256_and_si256( is_upper, _mm256_set1_epi8( 'a' - 'A' ) ) );
+        }
+        CATCHKIT_TARGET_AVX2 auto load_block_avx2( char const* data ) -> __m256i {
+            return _mm256_loadu_si256( reinterpret_cast<__m256i const*>( data ) );
+        }
+
+        CATCHKIT_TARGET_AVX2 auto equal_ignoring_case_avx2( std::string_view str1, std::string_view str2 ) -> bool {
+            if( str1.size() != str2.size() )
+                return false;
+            std::size_t i = 0;
+            for( ; i + 32 <= str1.size(); i += 32 ) {
+                auto const matches = _mm256_cmpeq_epi8( fold_block_avx2( load_block_avx2( str1.data() + i ) ), fold_block_avx2( load_block_avx2( str2.data() + i ) ) );
+                if( static_cast<unsigned>( _mm256_movemask_epi8( matches ) ) != 0xffffffffu )
+                    return false;
+            }
+            return equal_ignoring_case_sse2( str1.substr( i ), str2.substr( i ) );
+        }
+
+        CATCHKIT_TARGET_AVX2 auto find_ignoring_case_avx2( std::string_view str, std::string_view substr ) -> std::size_t {
+            if( substr.empty() )
+                return 0;
+            if( substr.size() > str.size() )
+                return std::string_view::npos;
+
+            auto const first = _mm256_set1_epi8( static_cast<char>( fold( substr.front() ) ) );
+            auto const last = _mm256_set1_epi8( static_cast<char>( fold( substr.back() ) ) );
+            auto const candidates_end = str.size() - substr.size() + 1;
+            std::size_t i = 0;
+            for( ; i + 32 <= candidates_end; i += 32 ) {
+                auto const matches = _mm256_and_si256(
+                    _mm256_cmpeq_epi8( fold_block_avx2( load_block_avx2( str.data() + i ) ), first ),
+                    _mm256_cmpeq_epi8( fold_block_avx2( load_block_avx2( str.data() + i + substr.size() - 1 ) ), last ) );
+                auto const mask = static_cast<unsigned>( _mm256_movemask_epi8( matches ) );
+                if( mask != 0 ) {
+                    if( auto pos = verify_candidates<equal_ignoring_case_avx2>( str, substr, i, mask ); pos != std::string_view::npos )
+                        return pos;
+                }
+            }
+            return find_tail( str, substr, i );
+        }
+
+#endif // CATCHKIT_ARCH_X86_64
+
+        struct StringSearchFunctions {
+            std::string_view name;
+            bool (*equal)( std::string_view, std::string_view );
+            std::size_t (*find)( std::string_view, std::string_view );
+        };
+
+        auto get_string_search_functions() -> StringSearchFunctions const& {
+            static StringSearchFunctions const functions = []() -> StringSearchFunctions { // NOSONAR NOLINT (misc-typo)
+#ifdef CATCHKIT_ARCH_X86_64
+                if( cpu_has_avx2() )
+                    return { "avx2", equal_ignoring_case_avx2, find_ignoring_case_avx2 };
+                return { "sse2", equal_ignoring_case_sse2, find_ignoring_case_sse2 };
+#else
+                return { "scalar", equal_ignoring_case_scalar, find_ignoring_case_scalar };
+#endif
+            }();
+            return functions;
+        }
+    }
+
+    auto equal_ignoring_case_scalar( std::string_view str1, std::string_view str2 ) -> bool {
+        if( str1.size() != str2.size() )
+            return false;
+        for( std::size_t i = 0; i < str1.size(); ++i ) {
+            if( fold( str1[i] ) != fold( str2[i] ) )
+                return false;
+        }
+        return true;
+    }
+
+    auto find_ignoring_case_scalar( std::string_view str, std::string_view substr ) -> std::size_t {
+        if( substr.empty() )
+            return 0;
+        if( substr.size() > str.size() )
+            return std::string_view::npos;
+        auto const first = fold( substr.front() );
+        for( std::size_t i = 0; i + substr.size() <= str.size(); ++i ) {
+            if( fold( str[i] ) == first && equal_ignoring_case_scalar( str.substr( i + 1, substr.size() - 1 ), substr.substr( 1 ) ) )
+                return i;
+        }
+        return std::string_view::npos;
+    }
+
+    auto equal_ignoring_case( std::string_view str1, std::string_view str2 ) -> bool {
+        return get_string_search_functions().equal( str1, str2 );
+    }
+
+    auto find_ignoring_case( std::string_view str, std::string_view substr ) -> std::size_t {
+        return get_string_search_functions().find( str, substr );
+    }
+
+    auto string_search_implementation() -> std::string_view {
+        return get_string_search_functions().name;
+    }
+
+} // namespace CatchKit::Detail
@@ -4,6 +4,8 @@
 
 #include "catchkit/stringify.h"
 
+#include <utility>
+
 namespace CatchKit {
     auto pointer_to_string( std::uintptr_t p ) -> std::string {
         return std::format("{:#x}", p);
@@ -16,4 +18,25 @@ namespace CatchKit {
             result += std::format("{:02x}", bytes[i]);
         return result;
     }
+    auto get_stringify_buffer() -> std::string& {
+        thread_local std::string buffer; // NOSONAR NOLINT (misc-typo)
+        return buffer;
+    }
+
+    namespace {
+        auto current_stringify_limits() -> StringifyLimits& {
+            thread_local StringifyLimits limits; // NOSONAR NOLINT (misc-typo)
+            return limits;
+        }
+    }
+    auto get_stringify_limits() -> StringifyLimits const& {
+        return current_stringify_limits();
+    }
+
+    ScopedStringifyLimits::ScopedStringifyLimits( StringifyLimits const& limits )
+    :   previous( std::exchange( current_stringify_limits(), limits ) )
+    {}
+    ScopedStringifyLimits::~ScopedStringifyLimits() {
+        current_stringify_limits() = previous;
+    }
 }
@@ -0,0 +1,122 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/diff.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/meta_test.h"
+    #include "catch23/test.h"
+    #include "catchkit/matchers.h"
+#endif
+
+#include "catchkit/expression_info.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace CatchKit::Detail;
+
+namespace {
+    int evaluations = 0;
+    auto next_values() {
+        ++evaluations;
+        return std::vector<int>{ 1, evaluations, 3 };
+    }
+
+    auto diff_of( std::string_view expected, std::string_view actual, std::size_t max_edits = 1'000 ) {
+        return diff_sequences( expected.size(), actual.size(),
+            [&]( std::size_t e, std::size_t a ) { return expected[e] == actual[a]; }, max_edits );
+    }
+    // Replays the runs, so we can check they describe the two sequences
+    auto edit_count( Diff const& diff ) {
+        std::size_t edits = 0;
+        for( auto const& run : diff.runs )
+            if( run.type != DiffRun::Type::Same )
+                edits += run.length;
+        return edits;
+    }
+}
+
+TEST("Diffs find the fewest edits between two sequences") {
+    SECTION("Identical sequences have no differences") {
+        auto diff = diff_of( "abcdef", "abcdef" );
+        CHECK_FALSE( diff.has_differences() );
+        CHECK( diff.runs.size() == 1 );
+    }
+    SECTION("A changed element is removed, then added") {
+        auto diff = diff_of( "abcdef", "abXdef" );
+        REQUIRE( diff.runs.size() == 4 );
+        CHECK( diff.first_difference == 2 );
+        CHECK( diff.runs[1].type == DiffRun::Type::Removed );
+        CHECK( diff.runs[2].type == DiffRun::Type::Added );
+        CHECK( diff.runs[2].actual_index == 2 );
+    }
+    SECTION("Insertions and deletions in the middle") {
+        // The LCS is "BCBA" (or equivalent), so there are 7 + 6 - 2*4 edits
+        auto diff = diff_of( "ABCBDAB", "BDCABA" );
+        CHECK( diff.complete );
+        CHECK( edit_count( diff ) == 5 );
+    }
+    SECTION("Too many differences gives up, but still finds the first") {
+        auto diff = diff_of( "a0123456789z", "aabcdefghijz", 4 );
+        CHECK_FALSE( diff.complete );
+        CHECK( diff.first_difference == 1 );
+        CHECK( edit_count( diff ) == 20 );
+    }
+}
+
+TEST("Diffs of large sequences stay small") {
+    std::vector<int> expected( 1'000'000 );
+    for( std::size_t i = 0; i < expected.size(); ++i )
+        expected[i] = static_cast<int>( i );
+    auto actual = expected;
+    actual[500'000] = -1;
+
+    auto description = describe_range_mismatch( expected, actual );
+    CHECK_THAT( description, starts_with( "first difference at index 500000" ) );
+    CHECK_THAT( description, contains( "- 500000" ) && contains( "+ -1" ) );
+    CHECK( description.size() < 500 );
+}
+
+TEST("Failing equality matchers describe the mismatch") {
+    SECTION("Strings are compared by character") {
+        auto description = describe_string_mismatch<CatchKit::StringMatchers::CaseSensitive>(
+            "the quick brown fox", "the quick red fox" );
+        CHECK( description == "first difference at index 10\n\"the quick [-brown-]{+red+} fox\"" );
+    }
+    SECTION("Strings with more than one line are compared by line") {
+        auto description = describe_string_mismatch<CatchKit::StringMatchers::CaseSensitive>(
+            "one\ntwo\nthree", "one\n2\nthree" );
+        CHECK_THAT( description, contains( "\n  - two\n  + 2\n" ) );
+    }
+    SECTION("Ignoring case") {
+        CHECK( describe_string_mismatch<CatchKit::StringMatchers::CaseInsensitive>( "Hello", "hELLO" ).empty() );
+    }
+    SECTION("The mismatch is part of the expansion") {
+        auto results = LOCAL_TEST() {
+            std::vector<int> actual{ 1, 2, 3 };
+            std::vector<int> expected{ 1, 5, 3 };
+            CHECK_THAT( actual, equals( expected ) );
+        };
+        REQUIRE( results.size() == 1 );
+        auto match = std::get_if<CatchKit::MatchExpressionInfo>( &results[0].info.expression_info );
+        REQUIRE( match );
+        CHECK_THAT( match->mismatch, starts_with( "first difference at index 1" ) );
+    }
+    SECTION("The value shown and the mismatch come from the same, single, re-evaluation") {
+        evaluations = 0;
+        auto results = LOCAL_TEST() {
+            CHECK_THAT( next_values(), equals( std::vector<int>{ 1, 5, 3 } ) );
+        };
+        REQUIRE( results.size() == 1 );
+        CHECK( evaluations == 2 ); // once to match, once to describe
+        auto match = std::get_if<CatchKit::MatchExpressionInfo>( &results[0].info.expression_info );
+        REQUIRE( match );
+        CHECK( match->candidate_value == "[1, 2, 3]" );
+        CHECK_THAT( match->mismatch, contains( "+ 2" ) );
+    }
+}
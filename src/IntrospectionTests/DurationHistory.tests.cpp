@@ -0,0 +1,64 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/duration_history.h"
+#include "catch23/test_registry.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/test.h"
+#endif
+
+#include <filesystem>
+#include <fstream>
+
+using namespace std::chrono_literals;
+using CatchKit::Detail::DurationHistory;
+
+TEST("Test durations can be saved and reloaded") {
+    auto path = (std::filesystem::temp_directory_path() / "catch23_duration_history.tests.bin").string();
+    std::filesystem::remove( path );
+
+    CatchKit::TestInfo slow{ std::source_location::current(), "slow test" };
+    CatchKit::TestInfo fast{ std::source_location::current(), "fast test" };
+    CatchKit::TestInfo unseen{ std::source_location::current(), "unseen test" };
+
+    {
+        DurationHistory history;
+        CHECK_FALSE( history.load( path ) );
+        history.record( slow, 300ms );
+        history.record( fast, 100ms );
+        REQUIRE( history.save( path ) );
+    }
+    {
+        DurationHistory history;
+        REQUIRE( history.load( path ) );
+        CHECK( history.size() == 2 );
+        CHECK( history.find( slow ) == 300ms );
+        CHECK( history.find( fast ) == 100ms );
+        CHECK_FALSE( history.find( unseen ).has_value() );
+        CHECK( history.estimate( unseen ) == 200ms ); // the mean
+
+        SECTION("new measurements are merged in") {
+            history.record( slow, 100ms );
+            history.record( unseen, 50ms );
+            REQUIRE( history.save( path ) );
+
+            DurationHistory merged;
+            REQUIRE( merged.load( path ) );
+            CHECK( merged.size() == 3 );
+            CHECK( merged.find( slow ) == 200ms );
+            CHECK( merged.find( fast ) == 100ms );
+            CHECK( merged.find( unseen ) == 50ms );
+        }
+    }
+    SECTION("files that are not history files are ignored") {
+        std::ofstream( path, std::ios::trunc ) << "not a history file";
+        DurationHistory history;
+        CHECK_FALSE( history.load( path ) );
+        CHECK( history.empty() );
+    }
+    std::filesystem::remove( path );
+}
@@ -0,0 +1,122 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/event_stream.h"
+#include "catch23/process_pool.h"
+#include "catch23/test_registry.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/meta_test.h"
+    #include "catch23/test.h"
+#endif
+
+#include <chrono>
+#include <csignal>
+#include <ranges>
+#include <thread>
+
+using namespace CatchKit::Detail;
+
+TEST("Reporter events survive being encoded and decoded") {
+    std::string stream;
+    EventEncoder encoder( CatchKit::ReportOn::AllResults, [&stream]( std::string_view bytes ) { stream += bytes; } );
+
+    CatchKit::TestInfo test_info{ std::source_location::current(), "encoded test" };
+    CatchKit::AssertionContext context{ .macro_name = "CHECK", .original_expression = "a == b", .message = {} };
+
+    encoder.on_test_start( test_info );
+    encoder.on_assertion_start( context );
+    encoder.on_assertion_end( context, CatchKit::AssertionInfo{
+        CatchKit::AdjustedResult::Failed,
+        CatchKit::BinaryExpressionInfo{ "1", "2", "==" },
+        "with a message",
+        { CatchKit::CapturedVariable{ "a", "int", "1" } } } );
+    encoder.on_test_end( test_info, CatchKit::Counters{ .failed = 1 } );
+    encoder.on_test_complete();
+
+    CatchKit::MetaTestReporter reporter;
+    EventDecoder decoder;
+
+    SECTION("all at once") {
+        CHECK( decoder.decode( stream, reporter, test_info ) );
+        CHECK( stream.empty() );
+    }
+    SECTION("a byte at a time") {
+        std::string inbox;
+        bool complete = false;
+        for( auto c : stream ) {
+            CHECK_FALSE( complete );
+            inbox += c;
+            complete = decoder.decode( inbox, reporter, test_info );
+        }
+        CHECK( complete );
+    }
+
+    REQUIRE( reporter.results.size() == 1 );
+    auto const& result = reporter.results[0];
+    CHECK( result.failed() );
+    CHECK( result.context.macro_name == "CHECK" );
+    CHECK( result.context.original_expression == "a == b" );
+    CHECK( result.context.location.line() == context.location.line() );
+    CHECK( result.info.message == "with a message" );
+    REQUIRE( result.info.variables.size() == 1 );
+    CHECK( result.info.variables[0].value == "1" );
+
+    auto binary_info = std::get_if<CatchKit::BinaryExpressionInfo>( &result.info.expression_info );
+    REQUIRE( binary_info );
+    CHECK( binary_info->lhs == "1" );
+    CHECK( binary_info->rhs == "2" );
+    CHECK( binary_info->op == "==" );
+}
+
+TEST("A crashing test is reported as a failure when run in a process pool") {
+    if( !process_pool_is_supported() )
+        return;
+
+    std::vector<CatchKit::Detail::Test> tests;
+    tests.emplace_back( []( CatchKit::Checker& checker ) { CHECK( true ); },
+        CatchKit::TestInfo{ std::source_location::current(), "before crash" } );
+    tests.emplace_back( []( CatchKit::Checker& ) { std::raise( SIGSEGV ); },
+        CatchKit::TestInfo{ std::source_location::current(), "crashes" } );
+    tests.emplace_back( []( CatchKit::Checker& checker ) { CHECK( true ); },
+        CatchKit::TestInfo{ std::source_location::current(), "after crash" } );
+
+    auto test_ptrs = tests
+        | std::views::transform( []( auto const& test ) { return &test; } )
+        | std::ranges::to<std::vector<CatchKit::Detail::Test const*>>();
+
+    CatchKit::MetaTestReporter reporter;
+    run_tests_in_process_pool( test_ptrs, reporter, { .worker_count = 1 } );
+
+    CatchKit::MetaTestResults results{ std::move(reporter.results) };
+    REQUIRE( results.size() == 3 );
+    CHECK( results.failures() == 1 );
+    CHECK( results[1].info.message.find("signal") != std::string::npos );
+}
+
+TEST("A hanging test is killed when run in a process pool") {
+    if( !process_pool_is_supported() )
+        return;
+
+    using namespace std::chrono_literals;
+    std::vector<CatchKit::Detail::Test> tests;
+    tests.emplace_back( []( CatchKit::Checker& ) { std::this_thread::sleep_for( 1h ); },
+        CatchKit::TestInfo{ std::source_location::current(), "hangs", { CatchKit::Tags::timeout( 100ms ) } } );
+    tests.emplace_back( []( CatchKit::Checker& checker ) { CHECK( true ); },
+        CatchKit::TestInfo{ std::source_location::current(), "after hang" } );
+
+    auto test_ptrs = tests
+        | std::views::transform( []( auto const& test ) { return &test; } )
+        | std::ranges::to<std::vector<CatchKit::Detail::Test const*>>();
+
+    CatchKit::MetaTestReporter reporter;
+    run_tests_in_process_pool( test_ptrs, reporter, { .worker_count = 1 } );
+
+    CatchKit::MetaTestResults results{ std::move(reporter.results) };
+    REQUIRE( results.size() == 2 );
+    CHECK( results.failures() == 1 );
+    CHECK( results[0].info.message.contains( "timed out after 100ms" ) );
+}
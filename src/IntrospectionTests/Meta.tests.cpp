@@ -2,18 +2,30 @@
 // Created by Phil Nash on 24/07/2025.
 //
 
+#include "catch23/duration_history.h"
 #include "catch23/test_registry.h"
 #ifdef USE_CATCH23_MODULES
     #include "catch23/macros.h"
     import catch23;
 #else
     #include "catch23/meta_test.h"
+    #include "catch23/runner.h"
+    #include "catch23/sharding.h"
     #include "catch23/test.h"
     #include "catchkit/matchers.h"
 #endif
 
 #include "catchkit/expression_info.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+
 TEST("A test that can run tests") {
 
     auto results = LOCAL_TEST() {
@@ -118,4 +130,165 @@ TEST("Tests can be queried", ["test-tag"]) {
         auto const& info = tests[0]->test_info;
         REQUIRE( info.name == "Tests can be queried" );
     }
+    SECTION("Tests are registered in the order they are written") {
+        auto earlier = reg.find_test_by_name("A test that can run tests");
+        auto later = reg.find_test_by_name("Tests can be queried");
+        REQUIRE( earlier != nullptr );
+        REQUIRE( later != nullptr );
+        CHECK( earlier < later );
+    }
+}
+
+TEST("Tests can be run on multiple threads") {
+    std::vector<CatchKit::Detail::Test> tests;
+    for( int i = 0; i < 8; ++i ) {
+        tests.emplace_back(
+            [i]( CatchKit::Checker& checker ) {
+                CHECK( i == i );
+                CHECK( i % 2 == 0 );
+            },
+            CatchKit::TestInfo{ std::source_location::current(), std::format("threaded test {}", i) } );
+    }
+
+    CatchKit::MetaTestReporter reporter;
+    CatchKit::TestRunner runner( reporter, CatchKit::Config{ .jobs = 4 } );
+    runner.run_tests( tests );
+
+    CatchKit::MetaTestResults results{ std::move(reporter.results) };
+    CHECK( results.size() == 16 );
+    CHECK( results.failures() == 4 );
+}
+
+TEST("Tests are partitioned into shards stably") {
+    auto info = CatchKit::TestInfo{ std::source_location::current(), "stable name" };
+
+    // Changing this value would reshuffle everyone's shards
+    CHECK( CatchKit::Detail::hash_test_identity(info) == 12596616071596047934ULL );
+    CHECK( CatchKit::Detail::shard_for_test(info, 7) == 2 );
+
+    std::vector<CatchKit::Detail::Test> tests;
+    for( int i = 0; i < 20; ++i ) {
+        tests.emplace_back(
+            []( CatchKit::Checker& checker ) { CHECK( true ); },
+            CatchKit::TestInfo{ std::source_location::current(), std::format("sharded test {}", i) } );
+    }
+
+    std::size_t total_results = 0;
+    for( int shard = 0; shard < 3; ++shard ) {
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{ .shard_count = 3, .shard_index = shard } );
+        runner.run_tests( tests );
+        total_results += reporter.results.size();
+    }
+    CHECK( total_results == tests.size() );
+}
+
+TEST("Shards can be balanced by a shared, read-only history of test durations") {
+    using namespace std::chrono_literals;
+    auto path = (std::filesystem::temp_directory_path() / "catch23_balance_shards.tests.bin").string();
+
+    std::vector<int> tests_run;
+    std::vector<CatchKit::Detail::Test> tests;
+    {
+        CatchKit::Detail::DurationHistory history;
+        for( int i = 0; i < 20; ++i ) {
+            CatchKit::TestInfo info{ std::source_location::current(), std::format("balanced test {}", i) };
+            history.record( info, std::chrono::milliseconds( i * 10 ) );
+            tests.emplace_back( [i, &tests_run]( CatchKit::Checker& checker ) { tests_run.push_back( i ); CHECK( true ); }, std::move( info ) );
+        }
+        REQUIRE( history.save( path ) );
+    }
+
+    // Each shard runs its own share - and between them, every test runs exactly once
+    for( int shard = 0; shard < 3; ++shard ) {
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{ .shard_count = 3, .shard_index = shard, .shard_durations_file = path } );
+        runner.run_tests( tests );
+    }
+    std::ranges::sort( tests_run );
+    CHECK( tests_run == std::views::iota( 0, 20 ) | std::ranges::to<std::vector>() );
+
+    SECTION("A history that can't be read is an error, rather than falling back to hashing") {
+        std::filesystem::remove( path );
+        CatchKit::MetaTestReporter reporter;
+        CHECK_THAT( CatchKit::TestRunner( reporter, CatchKit::Config{ .shard_count = 3, .shard_durations_file = path } ),
+            throws<std::invalid_argument>() );
+    }
+    std::filesystem::remove( path );
+}
+
+TEST("Tests that run past their time limit are cancelled at the next assertion") {
+    using namespace std::chrono_literals;
+    auto slow_test = []( CatchKit::Checker& checker ) {
+        CHECK( true );
+        std::this_thread::sleep_for( 200ms );
+        CHECK( true );
+        CHECK( true );
+    };
+    std::vector<CatchKit::Detail::Test> tests;
+    tests.emplace_back( slow_test, CatchKit::TestInfo{ std::source_location::current(), "slow test" } );
+    tests.emplace_back( slow_test,
+        CatchKit::TestInfo{ std::source_location::current(), "slow test with longer limit", { CatchKit::Tags::timeout( 10s ) } } );
+
+    CatchKit::MetaTestReporter reporter;
+    CatchKit::TestRunner runner( reporter, CatchKit::Config{ .timeout = 50 } );
+    runner.run_tests( tests );
+
+    CatchKit::MetaTestResults results{ std::move(reporter.results) };
+    REQUIRE( results.size() == 5 );
+    CHECK( results.failures() == 1 );
+    CHECK( results[1].failed() );
+    CHECK( results[1].info.message.contains( "timed out after 50ms" ) );
+    CHECK( results[1].info.message.contains( "slow test" ) );
+}
+
+TEST("The run can be aborted after a number of failed tests") {
+    std::vector<CatchKit::Detail::Test> tests;
+    for( int i = 0; i < 20; ++i ) {
+        tests.emplace_back(
+            [i]( CatchKit::Checker& checker ) { CHECK( i < 0 ); },
+            CatchKit::TestInfo{ std::source_location::current(), std::format("failing test {}", i) } );
+    }
+
+    SECTION("serially") {
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{ .abort_after = 3 } );
+        runner.run_tests( tests );
+
+        CatchKit::MetaTestResults results{ std::move(reporter.results) };
+        CHECK( results.size() == 3 );
+    }
+    SECTION("on multiple threads") {
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{ .jobs = 4, .abort_after = 3 } );
+        runner.run_tests( tests );
+
+        // Tests that were cut short aren't reported at all. But any that the other workers had already finished
+        // when the third failure was reported still are - each one a full failure
+        CatchKit::MetaTestResults results{ std::move(reporter.results) };
+        CHECK( results.size() >= 3 );
+        CHECK( results.size() <= 3 + 3 );
+        CHECK( static_cast<std::size_t>( results.failures() ) == results.size() );
+    }
+}
+
+TEST("Tests can be made from callables of any size") {
+    std::array<int, 16> values{};
+    values.back() = 42;
+    auto big_test = [values]( CatchKit::Checker& checker ) { CHECK( values.back() == 42 ); };
+    static_assert( sizeof(big_test) > sizeof(CatchKit::Detail::TestFunction) );
+
+    std::vector<CatchKit::Detail::Test> tests;
+    tests.emplace_back( big_test, CatchKit::TestInfo{ std::source_location::current(), "big test" } );
+    tests.emplace_back( []( CatchKit::Checker& checker ) { CHECK( true ); },
+        CatchKit::TestInfo{ std::source_location::current(), "captureless test" } );
+    auto moved_tests = std::move( tests );
+
+    CatchKit::MetaTestReporter reporter;
+    CatchKit::TestRunner runner( reporter, CatchKit::Config{} );
+    runner.run_tests( moved_tests );
+
+    CatchKit::MetaTestResults results{ std::move(reporter.results) };
+    CHECK( results.size() == 2 );
+    CHECK( results.failures() == 0 );
 }
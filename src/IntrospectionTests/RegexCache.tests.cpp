@@ -0,0 +1,69 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/regex_cache.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/test.h"
+    #include "catchkit/matchers.h"
+#endif
+
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace CatchKit::Detail;
+
+TEST("Compiled patterns are cached") {
+    auto regex = get_compiled_regex( "a+b", false );
+    CHECK( get_compiled_regex( "a+b", false ) == regex );
+    CHECK( get_compiled_regex( "a+b", true ) != regex );
+
+    SECTION("The least recently used are dropped first") {
+        for( std::size_t i = 0; i < regex_cache_capacity; ++i ) {
+            get_compiled_regex( "a+b", false ); // keep it recently used
+            get_compiled_regex( "x{" + std::to_string( i ) + "}", false );
+        }
+        CHECK( get_compiled_regex( "a+b", false ) == regex );
+
+        for( std::size_t i = 0; i < regex_cache_capacity; ++i )
+            get_compiled_regex( "y{" + std::to_string( i ) + "}", false );
+        CHECK( get_compiled_regex( "a+b", false ) != regex );
+        CHECK( regex_matches( *regex, "aab" ) ); // but still usable
+    }
+    SECTION("Invalid patterns throw, and aren't cached") {
+        CHECK_THAT( get_compiled_regex( "a(b", false ), throws<std::regex_error>() );
+        CHECK_THAT( get_compiled_regex( "a(b", false ), throws<std::regex_error>() );
+    }
+}
+
+TEST("Simple patterns are matched without std::regex") {
+    struct Case {
+        std::string pattern;
+        std::string str;
+        bool ignore_case = false;
+    };
+    // Each is checked against std::regex_match
+    std::vector<Case> const cases{
+        { "abc", "abc" }, { "abc", "abcd" }, { "abc", "ABC" }, { "abc", "ABC", true },
+        { "^abc$", "abc" }, { "^abc$", "xabc" }, { "", "" }, { "", "a" },
+        { "ab.*", "abcdef" }, { "ab.*", "xab" }, { "ab.*$", "abc" }, { "^ab.*", "ab" },
+        { ".*ef", "abcdef" }, { ".*ef", "efx" }, { "^.*EF$", "abcdef", true },
+        { ".*cd.*", "abcdef" }, { ".*cd.*", "abdcef" }, { ".*", "" }, { ".*", "anything" },
+        { ".*a\\.b.*", "xa.by" }, { ".*a\\.b.*", "xacby" }, { "a\\*", "a*" }, { "a\\$", "a$" },
+        // . doesn't match line breaks
+        { ".*cd.*", "ab\ncdef" }, { ".*cd.*", "abcd\r\n" }, { "ab.*", "ab\n" }, { "abc", "abc\n" }
+    };
+    for( auto const& [pattern, str, ignore_case] : cases ) {
+        auto regex = get_compiled_regex( pattern, ignore_case );
+        CHECK( is_simple_regex( *regex ) ) << pattern;
+        auto flags = ignore_case ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript;
+        CHECK( regex_matches( *regex, str ) == std::regex_match( str, std::regex( pattern, flags ) ) ) << pattern << " on " << str;
+    }
+
+    for( auto pattern : { "a+", "a|b", "[ab]", "\\d", "a.b", ".*?a", "(ab)", "(a)\\1" } )
+        CHECK_FALSE( is_simple_regex( *get_compiled_regex( pattern, false ) ) ) << pattern;
+}
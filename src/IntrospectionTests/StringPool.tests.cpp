@@ -0,0 +1,66 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/string_pool.h"
+#include "catch23/test_index.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/test.h"
+#endif
+
+#include <format>
+#include <ranges>
+#include <string>
+
+using namespace CatchKit::Detail;
+
+TEST("The string pool holds one copy of each string") {
+    StringPool pool;
+    std::string text = "a string";
+    auto interned = pool.intern( text );
+    text[0] = 'x'; // the pool has its own copy
+
+    CHECK( interned == "a string" );
+    CHECK( pool.intern( "a string" ).data() == interned.data() );
+    CHECK( pool.find( "a string" ).has_value() );
+    CHECK_FALSE( pool.find( "x string" ).has_value() );
+    CHECK( pool.size() == 1 );
+
+    SECTION( "Views remain valid as the pool grows" ) {
+        for( int i = 0; i < 10'000; ++i )
+            pool.intern( std::format( "string {}", i ) );
+        pool.intern( std::string( 100'000, 'z' ) );
+
+        CHECK( pool.size() == 10'002 );
+        CHECK( interned == "a string" );
+        CHECK( pool.find( "string 9999" ).has_value() );
+    }
+}
+
+TEST("Test names and tags are interned") {
+    auto name = std::format( "test {}", 42 );
+    CatchKit::TestInfo first{ std::source_location::current(), name, { CatchKit::Tag( std::string( "tag" ) ) } };
+    CatchKit::TestInfo second{ std::source_location::current(), "test 42", { { "tag" } } };
+
+    CHECK( first.name.data() == second.name.data() );
+    CHECK( first.tags[0].name.data() == second.tags[0].name.data() );
+
+    SECTION( "And can be looked up by name in an index" ) {
+        std::vector<Test> tests;
+        for( int i = 0; i < 100; ++i )
+            tests.emplace_back( []( CatchKit::Checker& ) {}, CatchKit::TestInfo{ std::source_location::current(), std::format( "test {}", i % 40 ) } );
+        TestIndex index( tests
+            | std::views::transform( []( Test const& test ) { return &test; } )
+            | std::ranges::to<std::vector>() );
+
+        CHECK( index.find_by_name( "test 7" ) == 7 );
+        CHECK_FALSE( index.find_by_name( "test 40" ).has_value() );
+        auto with_name = index.with_name( "test 7" );
+        CHECK( with_name.count() == 3 );
+        CHECK( with_name.contains( 47 ) );
+        CHECK( with_name.contains( 87 ) );
+    }
+}
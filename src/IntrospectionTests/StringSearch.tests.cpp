@@ -0,0 +1,86 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catchkit/string_search.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/test.h"
+    #include "catchkit/matchers.h"
+#endif
+
+#include <string>
+#include <string_view>
+
+using namespace CatchKit::Detail;
+
+namespace {
+    // Long enough to go through whole blocks (of 16 or 32) as well as the scalar tail
+    // No letter appears in both cases, so the first match ignoring case is the first match
+    auto make_text( std::size_t size ) -> std::string {
+        std::string_view const alphabet = "The Quick brown fox, @[`{ jumps\x80\xc3";
+        std::string text;
+        for( std::size_t i = 0; i < size; ++i )
+            text += alphabet[i % alphabet.size()];
+        return text;
+    }
+    auto toggle_case( std::string text ) -> std::string {
+        for( auto& c : text ) {
+            if( c >= 'a' && c <= 'z' )
+                c = static_cast<char>( c - ( 'a' - 'A' ) );
+            else if( c >= 'A' && c <= 'Z' )
+                c = static_cast<char>( c + ( 'a' - 'A' ) );
+        }
+        return text;
+    }
+}
+
+TEST("Case insensitive comparison folds ASCII letters only") {
+    CHECK( string_search_implementation() != "" );
+
+    for( std::size_t size : { 0, 1, 15, 16, 17, 31, 32, 33, 100 } ) {
+        auto text = make_text( size );
+        auto toggled = toggle_case( text );
+        CHECK( equal_ignoring_case( text, toggled ) ) << size;
+        CHECK( equal_ignoring_case_scalar( text, toggled ) ) << size;
+
+        if( size != 0 ) {
+            // Only letters are folded, so @ and ` (or [ and {) don't match, even though they differ by the same bit
+            auto changed = toggled;
+            changed.back() = changed.back() == '@' ? '`' : '@';
+            CHECK_FALSE( equal_ignoring_case( text, changed ) ) << size;
+            CHECK_FALSE( equal_ignoring_case_scalar( text, changed ) ) << size;
+        }
+    }
+    CHECK_FALSE( equal_ignoring_case( "abc", "abcd" ) );
+    CHECK_FALSE( equal_ignoring_case( "@[", "`{" ) );
+}
+
+TEST("Case insensitive search finds the first match") {
+    auto text = make_text( 1'000 );
+
+    for( std::size_t pos : { 0, 1, 15, 16, 31, 32, 33, 500, 990 } ) {
+        for( std::size_t length : { 1, 2, 5, 10 } ) {
+            auto substr = toggle_case( text.substr( pos, length ) );
+            auto expected = text.find( text.substr( pos, length ) );
+            CHECK( find_ignoring_case( text, substr ) == expected ) << pos << ", " << length;
+            CHECK( find_ignoring_case_scalar( text, substr ) == expected ) << pos << ", " << length;
+        }
+    }
+    SECTION("At the very end") {
+        auto with_ending = text + "NeEdLe";
+        CHECK( find_ignoring_case( with_ending, "needle" ) == text.size() );
+        CHECK( find_ignoring_case( with_ending, "needles" ) == std::string_view::npos );
+    }
+    SECTION("Empty and too long substrings") {
+        CHECK( find_ignoring_case( text, "" ) == 0 );
+        CHECK( find_ignoring_case( "", "" ) == 0 );
+        CHECK( find_ignoring_case( "abc", "abcd" ) == std::string_view::npos );
+    }
+    SECTION("Through the matchers") {
+        CHECK_THAT( text + "Needle", contains<CaseInsensitive>( "nEEDLE" ) && ends_with<CaseInsensitive>( "NEEDLE" ) );
+        CHECK_THAT( text, !contains<CaseInsensitive>( "needle" ) && starts_with<CaseInsensitive>( "the quick" ) );
+    }
+}
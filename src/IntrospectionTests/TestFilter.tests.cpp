@@ -0,0 +1,137 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+#include "catch23/test_filter.h"
+#include "catch23/test_registry.h"
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/test.h"
+#endif
+
+#include <array>
+#include <format>
+#include <ranges>
+
+using namespace CatchKit::Detail;
+
+namespace {
+    auto make_test( std::string name, std::vector<CatchKit::Tag> tags, std::source_location location = std::source_location::current() ) {
+        return Test( []( CatchKit::Checker& ) { /* never run */ }, CatchKit::TestInfo{ location, std::move(name), std::move(tags) } );
+    }
+
+    auto make_tests() {
+        std::vector<Test> tests;
+        tests.push_back( make_test( "startup is fast", { {"fast"}, {"startup"} } ) );
+        tests.push_back( make_test( "startup with plugins", { {"slow"}, {"startup"} } ) );
+        tests.push_back( make_test( "shutdown", { {"fast"}, {"flaky"} } ) );
+        tests.push_back( make_test( "muted, but fast", { {"fast"}, CatchKit::Tags::mute } ) );
+        tests.push_back( make_test( "a, b and ~c", { {"fast-ish"} } ) );
+        return tests;
+    }
+
+    int lazy_tests_made = 0;
+    auto make_lazy_test( std::string name ) -> Test {
+        ++lazy_tests_made;
+        return make_test( std::move(name), { {"lazy"} } );
+    }
+    constexpr TestDescriptor lazy_descriptors[] = {
+        { +[] { return make_lazy_test( "lazy one" ); }, std::source_location::current(),
+            get_constant_test_header<[] { return test_header( "lazy one" )["lazy"]; }>() },
+        { +[] { return make_lazy_test( "lazy two" ); }, std::source_location::current(),
+            get_constant_test_header<[] { return test_header( "lazy two" )["lazy"]; }>() } };
+
+    inline CatchKit::Tag runtime_tag( "runtime" );
+
+    auto selected_names( TestIndex const& index, std::string_view spec ) -> std::string {
+        auto filter = TestFilter::parse( spec );
+        if( !filter )
+            return "error: " + filter.error();
+        std::vector<std::string_view> names;
+        filter->select( index ).for_each( [&]( std::size_t i ) { names.push_back( index.get_test( i ).name ); } );
+        return names
+            | std::views::join_with( std::string_view("|") )
+            | std::ranges::to<std::string>();
+    }
+}
+
+TEST("Wildcards match any sequence of characters") {
+    CHECK( wildcard_match( "abc", "abc" ) );
+    CHECK_FALSE( wildcard_match( "abc", "abcd" ) );
+    CHECK( wildcard_match( "a*", "abcd" ) );
+    CHECK( wildcard_match( "*d", "abcd" ) );
+    CHECK( wildcard_match( "a*c*", "abcd" ) );
+    CHECK( wildcard_match( "*", "" ) );
+    CHECK_FALSE( wildcard_match( "*x*", "abcd" ) );
+    CHECK( wildcard_match( "a*b*b", "abbab" ) );
+}
+
+TEST("Tests can be selected by name, tag and location") {
+    auto tests = make_tests();
+    TestIndex index( tests
+        | std::views::transform( []( Test const& test ) { return &test; } )
+        | std::ranges::to<std::vector>() );
+
+    CHECK( selected_names( index, "shutdown" ) == "shutdown" );
+    CHECK( selected_names( index, "  shutdown  " ) == "shutdown" );
+    CHECK( selected_names( index, "startup*" ) == "startup is fast|startup with plugins" );
+    CHECK( selected_names( index, "\"a, b and ~c\"" ) == "a, b and ~c" );
+    CHECK( selected_names( index, "[fast]" ) == "startup is fast|shutdown|muted, but fast" );
+    CHECK( selected_names( index, "[fast*]" ) == "startup is fast|shutdown|muted, but fast|a, b and ~c" );
+    CHECK( selected_names( index, "[startup][fast]" ) == "startup is fast" );
+    CHECK( selected_names( index, "[fast] ~[flaky]" ) == "startup is fast|muted, but fast" );
+    CHECK( selected_names( index, "~[fast]" ) == "startup with plugins|a, b and ~c" );
+    CHECK( selected_names( index, "shutdown,[slow]" ) == "startup with plugins|shutdown" );
+    CHECK( selected_names( index, "unknown" ) == "" );
+
+    auto location = tests[2].test_info.location;
+    CHECK( selected_names( index, std::format( "TestFilter.tests.cpp:{}", location.line() ) ) == "shutdown" );
+    // We don't know where a test ends, so we take the nearest one declared before the line
+    CHECK( selected_names( index, std::format( "IntrospectionTests/TestFilter.tests.cpp:{}", location.line() + 100 ) )
+        == "a, b and ~c" );
+    CHECK( selected_names( index, std::format( "Filter.tests.cpp:{}", location.line() ) ) == "" );
+}
+
+TEST("Malformed test specs are rejected") {
+    CHECK_FALSE( TestFilter::parse( "[unterminated" ).has_value() );
+    CHECK_FALSE( TestFilter::parse( "\"unterminated" ).has_value() );
+    CHECK_FALSE( TestFilter::parse( "[]" ).has_value() );
+    CHECK_FALSE( TestFilter::parse( "a,~" ).has_value() );
+    CHECK( TestFilter::parse( "a,,b" ).has_value() );
+}
+
+TEST("The registry selects tests by tag without rescanning them") {
+    TestRegistry registry( make_tests() );
+    CHECK( registry.find_all_tests_by_tag( "startup" ).size() == 2 );
+    CHECK( registry.find_all_tests_by_tag( "unknown" ).empty() );
+
+    auto filter = TestFilter::parse( "[fast]~shutdown" );
+    REQUIRE( filter.has_value() );
+    CHECK( registry.select( *filter ).size() == 2 );
+}
+
+TEST("The registry only makes the tests that are asked for") {
+    std::array descriptors{ &lazy_descriptors[0], &lazy_descriptors[1] };
+    lazy_tests_made = 0;
+    TestRegistry registry( descriptors, make_tests() );
+    CHECK( registry.get_index().size() == 7 );
+    CHECK( lazy_tests_made == 0 );
+
+    auto filter = TestFilter::parse( "lazy two" );
+    REQUIRE( filter.has_value() );
+    auto selected = registry.select( *filter );
+    REQUIRE( selected.size() == 1 );
+    CHECK( selected[0]->test_info.name == "lazy two" );
+    CHECK( lazy_tests_made == 1 );
+
+    CHECK( registry.find_test_by_name( "lazy two" ) == selected[0] );
+    CHECK( registry.find_all_tests_by_tag( "lazy" ).size() == 2 );
+    CHECK( lazy_tests_made == 2 );
+
+    SECTION( "Tests with tags that aren't constants are made up front" ) {
+        constexpr auto header = get_constant_test_header<[] { return test_header( "not lazy" )[runtime_tag]; }>();
+        CHECK( header == nullptr );
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created by Phil Nash on 17/10/2026.
+//
+
+// All the assertions in this file take the fast path, where the runner allows it
+#define CATCHKIT_CONFIG_FAST_PASS
+
+#ifdef USE_CATCH23_MODULES
+    #include "catch23/macros.h"
+    import catch23;
+#else
+    #include "catch23/meta_test.h"
+    #include "catch23/runner.h"
+    #include "catch23/test.h"
+#endif
+
+#include "catchkit/expression_info.h"
+
+#include <variant>
+#include <vector>
+
+namespace {
+    struct CountingReporter : CatchKit::MetaTestReporter {
+        using MetaTestReporter::MetaTestReporter;
+        CatchKit::Counters assertions;
+
+        void on_test_end( CatchKit::TestInfo const&, CatchKit::Counters const& counters ) override {
+            assertions = counters;
+        }
+    };
+}
+
+TEST("Passing assertions are only counted, unless they need to be reported") {
+    int evaluations = 0;
+    auto test_fun = [&evaluations]( CatchKit::Checker& checker ) {
+        for( int i = 0; i < 100; ++i )
+            CHECK( i >= 0 );
+        CHECK_FALSE( evaluations < 0 );
+        CHECK( (++evaluations, 1) == 2 );
+        CHECK( true );
+    };
+    std::vector<CatchKit::Detail::Test> tests;
+    tests.emplace_back( test_fun, CatchKit::TestInfo{ std::source_location::current(), "many passes" } );
+
+    SECTION("Only the failure is evaluated again, to decompose it") {
+        CountingReporter reporter( CatchKit::ReportOn::FailingTests );
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{} );
+        runner.run_tests( tests );
+
+        CHECK( evaluations == 2 );
+        CHECK( reporter.assertions.passed_explicitly == 102 );
+        CHECK( reporter.assertions.failed == 1 );
+        REQUIRE( reporter.results.size() == 1 );
+        auto binary = std::get_if<CatchKit::BinaryExpressionInfo>( &reporter.results[0].info.expression_info );
+        REQUIRE( binary );
+        CHECK( binary->lhs == "1" );
+        CHECK( binary->rhs == "2" );
+    }
+    SECTION("Reporting passes turns the fast path off") {
+        CountingReporter reporter( CatchKit::ReportOn::AllResults );
+        CatchKit::TestRunner runner( reporter, CatchKit::Config{} );
+        runner.run_tests( tests );
+
+        CHECK( evaluations == 1 );
+        CHECK( reporter.assertions.passed_explicitly == 102 );
+        CHECK( reporter.results.size() == 103 );
+    }
+}
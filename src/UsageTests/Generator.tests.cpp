@@ -8,8 +8,11 @@
     #include "catch23/test.h"
     #include "catch23/generators.h"
     #include "catch23/meta_test.h"
+    #include "catch23/runner.h"
 #endif
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -151,4 +154,78 @@ TEST_CASE( "#2615 - Throwing in constructor generator fails test case but does n
     auto sample = GENERATE( throwing_generator() );
     // this assertion shouldn't trigger
     REQUIRE( sample == 0 );
-}
\ No newline at end of file
+}
+
+TEST("Paths through a test can be split across threads") {
+    CatchKit::Detail::Test test(
+        []( CatchKit::Checker& checker ) {
+            auto i = GENERATE(from_values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+            GENERATE(3, values_of<int>{});
+            CHECK( i <= 10 );
+        },
+        { std::source_location::current(), "split paths" } );
+
+    CatchKit::MetaTestReporter reporter;
+    CatchKit::TestResultHandler handler( reporter );
+    CatchKit::Detail::run_test_paths_in_parallel( test, handler, 4 );
+
+    REQUIRE( reporter.results.size() == 30 );
+    std::map<std::string, int> times_seen;
+    for( auto const& result : reporter.results ) {
+        CHECK( result.passed() );
+        if( auto binary_info = std::get_if<CatchKit::BinaryExpressionInfo>( &result.info.expression_info ) )
+            times_seen[binary_info->lhs]++;
+    }
+    CHECK( times_seen.size() == 10 );
+    for( auto const& [value, count] : times_seen )
+        CHECK( count == 3 );
+}
+
+TEST("Nested generators produce the same values in every partition of the paths") {
+    static std::mutex values_mutex;
+    static std::map<int, std::vector<int>> nested_values; // for each outer value, in the order they were generated
+    CatchKit::Detail::Test test(
+        []( CatchKit::Checker& checker ) {
+            auto i = GENERATE(from_values{1, 2, 3, 4, 5, 6, 7, 8});
+            auto j = GENERATE(3, values_of<int>{});
+            std::scoped_lock lock( values_mutex );
+            nested_values[i].push_back( j );
+        },
+        { std::source_location::current(), "split nested paths" } );
+
+    auto run_partitions = [&test]( unsigned int seed, std::size_t stride ) {
+        nested_values.clear();
+        for( std::size_t offset = 0; offset < stride; ++offset ) {
+            CatchKit::MetaTestReporter reporter;
+            CatchKit::TestResultHandler handler( reporter );
+            CatchKit::Detail::run_test_paths( test, handler, CatchKit::Detail::PathPartition{ .offset = offset, .stride = stride, .seed = seed } );
+        }
+        return nested_values;
+    };
+
+    // As in a serial run, the nested generator starts again from the same seed (derived from the partition's)
+    // for each outer value
+    auto const unsplit = run_partitions( 42, 1 );
+    REQUIRE( unsplit.size() == 8 );
+    auto const expected = unsplit.at( 1 );
+    CHECK( expected.size() == 3 );
+    for( auto const& [i, values] : unsplit )
+        CHECK( values == expected );
+
+    // Split four ways, every partition produces exactly those values
+    CHECK( run_partitions( 42, 4 ) == unsplit );
+
+    // They come from the partition's seed - not from each partition's own nodes
+    CHECK( run_partitions( 43, 4 ).at( 1 ) != expected );
+
+    SECTION("Across threads") {
+        nested_values.clear();
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestResultHandler handler( reporter );
+        CatchKit::Detail::run_test_paths_in_parallel( test, handler, 4 );
+
+        REQUIRE( nested_values.size() == 8 );
+        for( auto const& [i, values] : nested_values )
+            CHECK( values == nested_values.at( 1 ) );
+    }
+}
@@ -14,10 +14,18 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <cmath>
+#include <limits>
 #include <list>
+#include <ranges>
+#include <span>
 #include <sstream>
+#include <string>
+#include <vector>
 
 void non_throwing_function() {}
 void throwing_function(std::string const& message = {}) {
@@ -991,3 +999,293 @@ TEST_CASE( "Matchers can take references",
 //     CHECK_THAT( smallest_non_zero, WithinULP( -smallest_non_zero, 2 ) );
 //     CHECK_THAT( smallest_non_zero, !WithinULP( -smallest_non_zero, 1 ) );
 // }
+
+TEST( "Contiguous ranges of integers, enums and bytes are compared as memory" ) {
+    enum class Colour : std::uint8_t { Red, Green, Blue };
+
+    std::vector<std::uint8_t> buffer( 100'000, 0xab );
+    auto copy = buffer;
+    CHECK_THAT( copy, equals( buffer ) );
+
+    copy[70'000] = 0;
+    CHECK_THAT( copy, !equals( buffer ) );
+    CHECK( CatchKit::Detail::first_mismatch( buffer, copy ) == 70'000 );
+    CHECK( CatchKit::Detail::first_mismatch( buffer, std::vector<std::uint8_t>( 10, 0xab ) ) == 10 );
+
+    std::array const colours{ Colour::Red, Colour::Blue };
+    std::vector const same_colours{ Colour::Red, Colour::Blue };
+    std::vector const other_colours{ Colour::Red, Colour::Green };
+    CHECK_THAT( same_colours, equals( colours ) );
+    CHECK_THAT( other_colours, !equals( colours ) );
+
+    std::array const bytes{ std::byte{ 1 }, std::byte{ 2 } };
+    std::vector const same_bytes{ std::byte{ 1 }, std::byte{ 2 } };
+    std::vector<std::byte> const no_bytes;
+    CHECK_THAT( same_bytes, equals( bytes ) );
+    CHECK_THAT( no_bytes, !equals( bytes ) );
+
+    // Floating point isn't compared bytewise, as -0.0 == 0.0
+    std::vector const negative_zero{ -0.0 };
+    std::vector const zero{ 0.0 };
+    CHECK_THAT( negative_zero, equals( zero ) );
+}
+
+namespace {
+    // Can only be compared for equality - no hashing, no ordering
+    struct OnlyEquatable {
+        int i;
+        friend bool operator==( OnlyEquatable const&, OnlyEquatable const& ) = default;
+    };
+    // Can be ordered, but not hashed
+    struct OnlyOrdered {
+        std::string name;
+        friend auto operator<=>( OnlyOrdered const&, OnlyOrdered const& ) = default;
+    };
+    template<typename T>
+    auto make_range( std::size_t size, auto make_element ) {
+        std::vector<T> range;
+        range.reserve( size );
+        for( std::size_t i = 0; i < size; ++i )
+            range.push_back( make_element( static_cast<int>( i % 50 ) ) ); // so there are plenty of repeats
+        return range;
+    }
+}
+
+TEST( "Matching in any order counts repeated elements" ) {
+    using CatchKit::Detail::UnorderedStrategy;
+    using CatchKit::Detail::choose_unordered_strategy;
+
+    auto check_strategy = []<typename T>( UnorderedStrategy expected_strategy, auto make_element ) {
+        // Large enough not to be compared pair by pair
+        auto range = make_range<T>( 1'000, make_element );
+        using Range = decltype( range );
+        CHECK( choose_unordered_strategy<Range, Range>( range.size() ) == expected_strategy );
+
+        auto reversed = range;
+        std::ranges::reverse( reversed );
+        CHECK_THAT( reversed, equals<InAnyOrder>( range ) );
+        CHECK_THAT( reversed, contains( range ) );
+
+        // Same size, and the same elements, but a different number of each
+        auto changed = reversed;
+        changed.back() = changed.front();
+        CHECK_THAT( changed, !equals<InAnyOrder>( range ) );
+        CHECK_THAT( changed, !contains( range ) );
+
+        auto needles = range;
+        needles.resize( 60 ); // the first ten elements are there twice
+        CHECK_THAT( reversed, contains( needles ) );
+        needles.resize( 120 ); // and now some are there three times
+        CHECK_THAT( needles, !contains( std::vector( 4, range.front() ) ) );
+        CHECK_THAT( reversed, contains( needles ) );
+    };
+
+    SECTION( "Small ranges are compared pair by pair" ) {
+        std::vector const one_two_two{ 1, 2, 2 };
+        std::vector const one_one_two{ 1, 1, 2 };
+        std::vector const two_one_two{ 2, 1, 2 };
+        std::vector const one_two{ 1, 2 };
+        CHECK_THAT( one_two_two, !equals<InAnyOrder>( one_one_two ) );
+        CHECK_THAT( one_two_two, equals<InAnyOrder>( two_one_two ) );
+        CHECK_THAT( one_two, !equals<InAnyOrder>( one_one_two ) );
+        CHECK_THAT( one_one_two, !equals<InAnyOrder>( one_two ) );
+        CHECK_THAT( one_two_two, contains( one_two ) );
+        CHECK_THAT( one_two, !contains( one_two_two ) );
+        CHECK_THAT( one_one_two, !contains( one_two_two ) );
+        CHECK( choose_unordered_strategy<std::vector<int>, std::vector<int>>( 3 ) == UnorderedStrategy::Quadratic );
+    }
+    SECTION( "Integers are sorted" ) {
+        check_strategy.operator()<int>( UnorderedStrategy::Sorted, []( int i ) { return i; } );
+    }
+    SECTION( "Strings are hashed" ) {
+        check_strategy.operator()<std::string>( UnorderedStrategy::Hashed, []( int i ) { return std::to_string( i ); } );
+    }
+    SECTION( "Floating point is hashed" ) {
+        check_strategy.operator()<double>( UnorderedStrategy::Hashed, []( int i ) { return i * 0.5; } );
+    }
+    SECTION( "Types that can't be hashed are sorted" ) {
+        check_strategy.operator()<OnlyOrdered>( UnorderedStrategy::Sorted, []( int i ) { return OnlyOrdered{ std::to_string( i ) }; } );
+    }
+    SECTION( "Types that can only be compared for equality are compared pair by pair" ) {
+        check_strategy.operator()<OnlyEquatable>( UnorderedStrategy::Quadratic, []( int i ) { return OnlyEquatable{ i }; } );
+    }
+    SECTION( "Elements of different types are sorted or hashed as their common type" ) {
+        auto longs = make_range<long>( 1'000, []( int i ) { return static_cast<long>( i ); } );
+        auto ints = make_range<int>( 1'000, []( int i ) { return i; } );
+        std::ranges::reverse( ints );
+        CHECK( choose_unordered_strategy<std::vector<long>, std::vector<int>>( longs.size() ) == UnorderedStrategy::Sorted );
+        CHECK_THAT( longs, equals<InAnyOrder>( ints ) );
+        CHECK_THAT( longs, contains( ints ) );
+
+        ints.back() = -1;
+        CHECK_THAT( longs, !equals<InAnyOrder>( ints ) );
+    }
+}
+
+TEST( "Floating point ranges can be matched element by element, as one assertion" ) {
+    std::vector<double> expected( 1'000 );
+    for( std::size_t i = 0; i < expected.size(); ++i )
+        expected[i] = std::sin( static_cast<double>( i ) );
+    auto actual = expected;
+
+    CHECK_THAT( actual, all_close_to( expected, 1e-12 ) );
+    CHECK_THAT( actual, all_close_to_rel( expected ) );
+    CHECK_THAT( actual, all_within_ulp( expected, 0 ) );
+
+    actual[10] = std::nextafter( actual[10], 2.0 );
+    actual[20] = std::nextafter( std::nextafter( actual[20], 2.0 ), 2.0 );
+    CHECK_THAT( actual, all_within_ulp( expected, 2 ) );
+    CHECK_THAT( actual, !all_within_ulp( expected, 1 ) );
+    CHECK_THAT( actual, all_close_to( expected, 1e-12 ) );
+
+    SECTION( "Failures count every element that's out of tolerance, and list the worst" ) {
+        actual[500] += 0.5;
+        actual[999] = std::numeric_limits<double>::quiet_NaN();
+        for( std::size_t i = 100; i < 110; ++i )
+            actual[i] += 1e-3;
+
+        auto description = CatchKit::Detail::describe_out_of_tolerance(
+            std::span<double const>( expected ), std::span<double const>( actual ), CatchKit::Detail::AbsoluteTolerance{ 1e-6 } );
+        CHECK_THAT( description, starts_with( "12 of 1000 elements out of tolerance. The worst:\n  [999] expected" ) );
+        CHECK_THAT( description, contains( "(off by nan)" ) && contains( "\n  [500] expected" ) );
+        CHECK( std::ranges::count( description, '\n' ) == CatchKit::Detail::max_reported_out_of_tolerance );
+    }
+    SECTION( "Ranges of different sizes never match" ) {
+        actual.pop_back();
+        CHECK_THAT( actual, !all_close_to( expected, 1.0 ) );
+    }
+    SECTION( "floats, in any contiguous range" ) {
+        std::array const expected_floats{ 1.0f, -0.0f, 3.5f };
+        std::vector const actual_floats{ std::nextafter( 1.0f, 2.0f ), 0.0f, 3.5f };
+        CHECK_THAT( actual_floats, all_within_ulp( expected_floats ) );
+        CHECK_THAT( actual_floats, all_close_to( expected_floats ) );
+        CHECK_THAT( actual_floats, !all_close_to( expected_floats, 0.0 ) );
+        CHECK( all_within_ulp( expected_floats, 2 ).describe().description == "all_within_ulp([1, -0, 3.5], 2)" );
+        CHECK( all_close_to( expected_floats, 0.5 ).describe().description == "all_close_to([1, -0, 3.5], 0.5)" );
+    }
+    CHECK( CatchKit::Detail::ulp_distance( -0.0, 0.0 ) == 0 );
+    CHECK( CatchKit::Detail::ulp_distance( -std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::denorm_min() ) == 2 );
+}
+
+TEST( "Every, any or no element of a range can be matched, as one assertion" ) {
+    std::vector<int> values{ 1, 3, 5, 7, 9 };
+
+    CHECK_THAT( values, all_match( matches_predicate( []( int value ) { return value % 2 == 1; }, "is_odd" ) ) );
+    CHECK_THAT( values, any_match( matches_predicate( []( int value ) { return value > 8; }, "is_big" ) ) );
+    CHECK_THAT( values, none_match( matches_predicate( []( int value ) { return value % 2 == 0; }, "is_even" ) ) );
+    CHECK_THAT( values, !any_match( matches_predicate( []( int value ) { return value > 9; }, "is_bigger" ) ) );
+    std::vector<int> no_values;
+    CHECK_THAT( no_values, all_match( matches_predicate( []( int ) { return false; } ) ) );
+    CHECK_THAT( no_values, !any_match( matches_predicate( []( int ) { return true; } ) ) );
+
+    SECTION( "with composite matchers" ) {
+        std::list<std::string> words{ "amaze", "analyse", "apologise" };
+        CHECK_THAT( words, all_match( starts_with( "a" ) && ( ends_with( "se" ) || ends_with( "ze" ) ) ) );
+        CHECK_THAT( words, none_match( contains( "z" ) && contains( "p" ) ) );
+        CHECK_THAT( words, !all_match( contains<CaseInsensitive>( "LYS" ) || contains( "maz" ) ) );
+    }
+    SECTION( "Failures report the first few elements that caused them" ) {
+        auto results = LOCAL_TEST() {
+            std::vector<int> numbers( 100 );
+            for( std::size_t i = 0; i < numbers.size(); ++i )
+                numbers[i] = static_cast<int>( i );
+            CHECK_THAT( numbers, all_match( matches_predicate( []( int value ) { return value < 10; }, "is_small" ) ) );
+            CHECK_THAT( numbers, none_match( matches_predicate( []( int value ) { return value == 42; }, "is_the_answer" ) ) );
+        };
+        REQUIRE( results.size() == 2 );
+        auto all_info = std::get_if<CatchKit::MatchExpressionInfo>( &results[0].info.expression_info );
+        REQUIRE( all_info );
+        REQUIRE( all_info->sub_expressions.size() == CatchKit::Detail::max_reported_elements );
+        CHECK( all_info->sub_expressions[0].description == "[10] 10 is_small" );
+        CHECK( all_info->sub_expressions[4].description == "[14] 14 is_small" );
+        CHECK_FALSE( all_info->sub_expressions[0].result );
+
+        auto none_info = std::get_if<CatchKit::MatchExpressionInfo>( &results[1].info.expression_info );
+        REQUIRE( none_info );
+        REQUIRE( none_info->sub_expressions.size() == 1 );
+        CHECK( none_info->sub_expressions[0].description == "[42] 42 is_the_answer" );
+        CHECK( none_info->sub_expressions[0].result );
+    }
+    SECTION( "Large random access ranges can be matched across threads" ) {
+        std::vector<std::uint32_t> numbers( 4 * CatchKit::Detail::parallel_elements_threshold );
+        for( std::size_t i = 0; i < numbers.size(); ++i )
+            numbers[i] = static_cast<std::uint32_t>( i * 2 );
+        auto is_even = CatchKit::Matchers::matches_predicate( []( std::uint32_t value ) { return value % 2 == 0; }, "is_even" );
+        CHECK_THAT( numbers, all_match( is_even, InParallel::Yes ) );
+
+        numbers[200'000] = 1;
+        numbers[100'001] = 3;
+        CHECK_THAT( numbers, !all_match( is_even, InParallel::Yes ) );
+        CHECK_THAT( numbers, any_match( !is_even, InParallel::Yes ) );
+
+        auto results = LOCAL_TEST() {
+            std::vector<std::uint32_t> odd_ones_out( 4 * CatchKit::Detail::parallel_elements_threshold, 2 );
+            odd_ones_out[200'000] = 1;
+            odd_ones_out[100'001] = 3;
+            CHECK_THAT( odd_ones_out, all_match( matches_predicate( []( std::uint32_t value ) { return value % 2 == 0; }, "is_even" ), InParallel::Yes ) );
+        };
+        REQUIRE( results.size() == 1 );
+        auto info = std::get_if<CatchKit::MatchExpressionInfo>( &results[0].info.expression_info );
+        REQUIRE( info );
+        REQUIRE( info->sub_expressions.size() == 2 );
+        CHECK( info->sub_expressions[0].description == "[100001] 3 is_even" );
+        CHECK( info->sub_expressions[1].description == "[200000] 1 is_even" );
+    }
+}
+
+TEST( "Range matchers compare ranges that can only be read once, as they're read" ) {
+    std::vector<int> expected{ 1, 2, 3, 4, 5 };
+    std::vector<int> some{ 4, 2 };
+
+    std::istringstream in_order( "1 2 3 4 5" );
+    CHECK_THAT( std::views::istream<int>( in_order ), equals( expected ) );
+    std::istringstream in_any_order( "3 1 5 2 4" );
+    CHECK_THAT( std::views::istream<int>( in_any_order ), equals<InAnyOrder>( expected ) );
+    std::istringstream too_short( "1 2 3 4" );
+    CHECK_THAT( std::views::istream<int>( too_short ), !equals( expected ) );
+    std::istringstream repeated( "1 2 3 4 5 5" );
+    CHECK_THAT( std::views::istream<int>( repeated ), !equals<InAnyOrder>( expected ) );
+    std::istringstream haystack( "9 4 7 2 8" );
+    CHECK_THAT( std::views::istream<int>( haystack ), contains( some ) );
+    std::istringstream element_haystack( "9 4 7 2 8" );
+    CHECK_THAT( std::views::istream<int>( element_haystack ), contains( 7 ) );
+    std::istringstream numbers( "2 4 6" );
+    CHECK_THAT( std::views::istream<int>( numbers ), all_match( matches_predicate( []( int value ) { return value % 2 == 0; }, "is_even" ) ) );
+
+    SECTION( "Ranges without a size are compared in the same way" ) {
+        std::vector<int> odd_values{ 1, 3, 5 };
+        auto odd = expected | std::views::filter( []( int value ) { return value % 2 == 1; } );
+        CHECK_THAT( odd, equals( odd_values ) );
+        CHECK_THAT( odd, !equals( expected ) );
+        CHECK_THAT( odd, contains( 3 ) && !contains( 2 ) );
+    }
+    SECTION( "Failures are described from what was read" ) {
+        auto results = LOCAL_TEST() {
+            std::vector<int> hundred( 100 );
+            std::ostringstream text;
+            for( std::size_t i = 0; i < hundred.size(); ++i ) {
+                hundred[i] = static_cast<int>( i );
+                if( i == 50 )
+                    text << "-1 ";
+                text << i << ' ';
+            }
+            // Only the elements up to a window past the first difference are read
+            std::istringstream in( text.str() );
+            CHECK_THAT( std::views::istream<int>( in ), equals( hundred ) );
+
+            std::istringstream missing( "1 2 3" );
+            CHECK_THAT( std::views::istream<int>( missing ), equals<InAnyOrder>( hundred ) );
+        };
+        REQUIRE( results.size() == 2 );
+        auto info = std::get_if<CatchKit::MatchExpressionInfo>( &results[0].info.expression_info );
+        REQUIRE( info );
+        CHECK( info->candidate_value == std::format( "{{ single pass range: {} elements read }}", 50 + CatchKit::Detail::streamed_window_size ) );
+        CHECK( info->mismatch.starts_with( "first difference at index 50" ) );
+        CHECK( info->mismatch.contains( "+ -1" ) );
+
+        auto any_order_info = std::get_if<CatchKit::MatchExpressionInfo>( &results[1].info.expression_info );
+        REQUIRE( any_order_info );
+        CHECK( any_order_info->candidate_value == "{ single pass range: 3 elements read }" );
+        CHECK( any_order_info->mismatch.starts_with( "97 of the expected elements weren't found:" ) );
+    }
+}
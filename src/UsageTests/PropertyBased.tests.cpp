@@ -8,6 +8,7 @@
     #include "catch23/test.h"
     #include "catch23/generators.h"
     #include "catch23/meta_test.h"
+    #include "catch23/runner.h"
 #endif
 
 #include <utility>
@@ -44,3 +45,26 @@ TEST("sparse decomposition", [mute]) {
 
     CHECK( a+b == N);
 }
+
+TEST("Shrink candidates can be tried in batches") {
+    CatchKit::Detail::Test test(
+        []( CatchKit::Checker& checker ) {
+            auto i = GENERATE(values_of<int>{ .from=0, .up_to=1000000 });
+            CHECK( i < 1000 );
+        },
+        { std::source_location::current(), "shrinking test" } );
+
+    auto shrink_with_batch_size = [&test]( std::size_t batch_size ) {
+        CatchKit::MetaTestReporter reporter;
+        CatchKit::TestResultHandler handler( reporter );
+        handler.set_shrink_batch_size( batch_size );
+        CatchKit::Detail::run_test_paths( test, handler );
+        return reporter.shrunk_values;
+    };
+
+    auto serial = shrink_with_batch_size( 1 );
+    REQUIRE( serial.size() == 1 );
+    CHECK( serial[0] == "1000" );
+
+    CHECK( shrink_with_batch_size( 8 ) == serial );
+}
@@ -6,7 +6,12 @@
     #include "catchkit/matchers.h"
 #endif
 
+#include <format>
+#include <iterator>
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 TEST("Built-ins can be converted to strings") {
     CHECK( CatchKit::stringify( 0 ) == "0" );
@@ -26,3 +31,76 @@ TEST("Built-ins can be converted to strings") {
 
     CHECK_THAT( CatchKit::stringify(p), starts_with("0x") && has_size(14) );
 }
+
+TEST("Values can be stringified straight into an existing buffer") {
+    std::string buffer = "x=";
+
+    CatchKit::stringify_to( std::back_inserter(buffer), 42 );
+    CHECK( buffer == "x=42" );
+
+    buffer += ", ";
+    CatchKit::stringify_to( std::back_inserter(buffer), std::string("string") );
+    CHECK( buffer == "x=42, \"string\"" );
+
+    SECTION("The text is the same as stringify gives") {
+        auto same_as_stringify = []( auto const& value ) {
+            std::string text;
+            CatchKit::stringify_to( std::back_inserter(text), value );
+            return text == CatchKit::stringify( value );
+        };
+        CHECK( same_as_stringify( -7 ) );
+        CHECK( same_as_stringify( 0.1f ) );
+        CHECK( same_as_stringify( 1e300 ) );
+        CHECK( same_as_stringify( true ) );
+        CHECK( same_as_stringify( 'c' ) );
+        CHECK( same_as_stringify( "char*" ) );
+        CHECK( same_as_stringify( nullptr ) );
+        CHECK( same_as_stringify( std::vector{ 1, 2, 3 } ) );
+    }
+}
+
+TEST("Strings and characters in ranges are quoted and escaped, as std::format shows them") {
+    std::vector<std::string> const strings{ "a\"b", "c\nd" };
+    CHECK( CatchKit::stringify( strings ) == R"(["a\"b", "c\nd"])" );
+    CHECK( CatchKit::stringify( strings ) == std::format( "{}", strings ) );
+    CHECK( CatchKit::stringify( std::vector{ 'a', '\'' } ) == R"(['a', '\''])" );
+    CHECK( CatchKit::stringify( std::map<std::string, char>{ { "k", 'v' } } ) == R"({"k": 'v'})" );
+}
+
+TEST("Stringified ranges and strings are cut short at the limits") {
+    CHECK( CatchKit::stringify( std::vector{ 1, 2, 3 } ) == "[1, 2, 3]" );
+    CHECK( CatchKit::stringify( std::vector<std::vector<int>>{ { 1 }, {} } ) == "[[1], []]" );
+
+    SECTION("Elements") {
+        CatchKit::ScopedStringifyLimits limits( { .max_elements = 2 } );
+        CHECK( CatchKit::stringify( std::vector{ 1, 2, 3 } ) == "[1, 2, ...]" );
+        CHECK( CatchKit::stringify( std::vector{ 1, 2 } ) == "[1, 2]" );
+    }
+    SECTION("Characters") {
+        CatchKit::ScopedStringifyLimits limits( { .max_chars = 8 } );
+        CHECK( CatchKit::stringify( std::vector{ 100, 200, 300 } ) == "[100, 20..." );
+        CHECK( CatchKit::stringify( std::string( 1'000'000, 'x' ) ) == "\"xxxxxxx..." );
+        CHECK( CatchKit::stringify( std::string( "short" ) ) == "\"short\"" );
+    }
+    SECTION("Depth") {
+        CatchKit::ScopedStringifyLimits limits( { .max_depth = 1 } );
+        CHECK( CatchKit::stringify( std::vector<std::vector<int>>{ { 1 }, {} } ) == "[[...], []]" );
+    }
+    SECTION("A huge range stops early") {
+        std::vector<int> const huge( 10'000'000, 7 );
+        auto text = CatchKit::stringify( huge );
+        CHECK( text.size() < 1'000 );
+        CHECK( text.ends_with( "7, ...]" ) );
+    }
+    SECTION("Limits only apply on the thread they were set on, while in scope") {
+        {
+            CatchKit::ScopedStringifyLimits limits( { .max_elements = 1 } );
+            CHECK( CatchKit::stringify( std::vector{ 1, 2 } ) == "[1, ...]" );
+
+            std::string from_other_thread;
+            std::jthread( [&from_other_thread] { from_other_thread = CatchKit::stringify( std::vector{ 1, 2 } ); } ).join();
+            CHECK( from_other_thread == "[1, 2]" );
+        }
+        CHECK( CatchKit::stringify( std::vector{ 1, 2 } ) == "[1, 2]" );
+    }
+}